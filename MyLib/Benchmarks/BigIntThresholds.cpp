@@ -0,0 +1,102 @@
+/*
+* Finds where BigInt multiplication should switch algorithm on this CPU, for the DP_BIGINT_*_THRESHOLD macros in BigIntKernels.h.
+* Each pair of neighbouring algorithms is timed at the top level on the same random operands over a range of sizes, and the crossover reported
+* is the first size from which the larger algorithm stays faster. The sub-products inside Karatsuba and Toom-3 still go through the thresholds
+* the library was built with, so after changing them it's worth building and running this once more to check the crossovers haven't moved.
+* This is a standalone program rather than part of the library. With GCC or Clang, from the MyLib directory:
+*
+*     g++ -std=c++17 -O2 -IHeaders Benchmarks/BigIntThresholds.cpp "Source Files"/BigIntKernels.cpp "Source Files"/SimpleTimer.cpp -pthread
+*/
+
+#include "BigIntKernels.h"
+#include "SimpleTimer.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace {
+
+	using dp::detail::limb_type;
+
+	using Multiply = std::function<void(limb_type*, const limb_type*, const limb_type*, std::size_t)>;
+
+	struct Contender {
+		const char* name;
+		Multiply multiply;
+	};
+
+	//The best of a few runs, each repeating the multiplication for long enough to be well above the clock's resolution. In seconds per multiplication.
+	double timeMultiply(const Multiply& multiply, std::size_t n, std::mt19937_64& random) {
+		std::vector<limb_type> a(n), b(n), out(2 * n);
+		std::generate(a.begin(), a.end(), std::ref(random));
+		std::generate(b.begin(), b.end(), std::ref(random));
+
+		constexpr double minimumRun{ 0.02 };
+		constexpr int runs{ 5 };
+		std::size_t repeats{ 1 };
+		for (dp::SimpleTimer timer; ; repeats *= 2) {
+			timer.reset();
+			for (std::size_t i = 0; i < repeats; ++i) multiply(out.data(), a.data(), b.data(), n);
+			if (timer.elapsed() >= minimumRun) break;
+		}
+
+		double best{ 0 };
+		for (int run = 0; run < runs; ++run) {
+			dp::SimpleTimer timer;
+			for (std::size_t i = 0; i < repeats; ++i) multiply(out.data(), a.data(), b.data(), n);
+			const double perMultiply{ timer.elapsed() / static_cast<double>(repeats) };
+			if (run == 0 || perMultiply < best) best = perMultiply;
+		}
+		return best;
+	}
+
+	//Times both contenders at each size, and returns the first size from which the larger one wins every time, or 0 if it never settles.
+	std::size_t findCrossover(const Contender& smaller, const Contender& larger, const std::vector<std::size_t>& sizes, std::mt19937_64& random) {
+		std::printf("\n%8s %14s %14s\n", "limbs", smaller.name, larger.name);
+		std::size_t crossover{ 0 };
+		for (std::size_t n : sizes) {
+			const double smallerTime{ timeMultiply(smaller.multiply, n, random) };
+			const double largerTime{ timeMultiply(larger.multiply, n, random) };
+			std::printf("%8zu %12.2fus %12.2fus%s\n", n, smallerTime * 1e6, largerTime * 1e6, largerTime < smallerTime ? "  *" : "");
+			if (largerTime >= smallerTime) crossover = 0;
+			else if (crossover == 0) crossover = n;
+		}
+		return crossover;
+	}
+
+	//Sizes from first to last, each about an eighth larger than the one before.
+	std::vector<std::size_t> sizeRange(std::size_t first, std::size_t last) {
+		std::vector<std::size_t> sizes;
+		for (std::size_t n = first; n <= last; n += std::max<std::size_t>(1, n / 8)) sizes.push_back(n);
+		return sizes;
+	}
+
+	void report(const char* macro, std::size_t crossover, std::size_t current) {
+		if (crossover == 0) std::printf("%s: no crossover in the sizes tried (currently %zu)\n", macro, current);
+		else std::printf("%s: %zu (currently %zu)\n", macro, crossover, current);
+	}
+
+}
+
+int main() {
+	namespace detail = dp::detail;
+	std::mt19937_64 random{ 1 };
+
+	const Contender schoolbook{ "schoolbook", [](limb_type* out, const limb_type* a, const limb_type* b, std::size_t n) { detail::mulSchoolbook(out, a, n, b, n); } };
+	const Contender karatsuba{ "karatsuba", [](limb_type* out, const limb_type* a, const limb_type* b, std::size_t n) { detail::mulKaratsuba(out, a, b, n); } };
+	const Contender toom3{ "toom-3", [](limb_type* out, const limb_type* a, const limb_type* b, std::size_t n) { detail::mulToom3(out, a, b, n); } };
+	const Contender ntt{ "ntt", [](limb_type* out, const limb_type* a, const limb_type* b, std::size_t n) { detail::mulNtt(out, a, n, b, n); } };
+
+	const std::size_t karatsubaCrossover{ findCrossover(schoolbook, karatsuba, sizeRange(8, 96), random) };
+	const std::size_t toom3Crossover{ findCrossover(karatsuba, toom3, sizeRange(64, 1024), random) };
+	const std::size_t nttCrossover{ findCrossover(toom3, ntt, sizeRange(1024, 24576), random) };
+
+	std::printf("\nCrossovers on this CPU (* marks the larger algorithm winning):\n");
+	report("DP_BIGINT_KARATSUBA_THRESHOLD", karatsubaCrossover, detail::karatsubaThreshold);
+	report("DP_BIGINT_TOOM3_THRESHOLD", toom3Crossover, detail::toom3Threshold);
+	report("DP_BIGINT_NTT_THRESHOLD", nttCrossover, detail::nttThreshold);
+	return 0;
+}
@@ -9,21 +9,125 @@
 #include<iostream>
 #include<vector>
 #include<string>
+#include<string_view>
 #include<limits>
+#include<cstdint>
+#include<utility>
+#include<tuple>
+#include<type_traits>
+#include<charconv>
+#include<memory_resource>
+
+#include "LimbBuffer.h"
 
 namespace dp {
 
+	/*
+	* A single-limb divisor with a precomputed reciprocal, for repeatedly dividing BigInts by the same small constant.
+	* Each limb of such a division costs a couple of multiplications rather than a hardware divide (Moller and Granlund's method).
+	*/
+	class InvariantDivisor
+	{
+		friend class BigInt;
+
+		std::uint64_t	m_divisor;
+		std::uint64_t	m_normalised;	//The divisor shifted up so that its most significant bit is set.
+		std::uint64_t	m_reciprocal;	//floor((2^128 - 1) / m_normalised) - 2^64
+		unsigned		m_shift;		//How far the divisor was shifted to normalise it.
+
+	public:
+		//As with the BigInt division operators, a divisor of 0 is UB.
+		explicit InvariantDivisor(std::uint64_t inDivisor);
+
+		std::uint64_t value() const;
+	};
+
+	template<std::size_t Bits>
+	class FixedInt;
+
+	template<typename Expression>
+	class BigIntExpr;
+
+	namespace detail {
+		struct SumTerm;
+
+		//The built-in types which BigInt's arithmetic and comparison operators take directly: every integer type but bool, and also __int128 and
+		//unsigned __int128 where the compiler has them, which std::is_integral only counts as integers in its GNU modes.
+		template<typename T>
+		struct isNativeInteger : std::bool_constant<std::is_integral_v<T> && !std::is_same_v<T, bool>> {};
+#if defined(__SIZEOF_INT128__)
+		template<>
+		struct isNativeInteger<__int128> : std::true_type {};
+		template<>
+		struct isNativeInteger<unsigned __int128> : std::true_type {};
+#endif
+
+		template<typename Integer, typename Result>
+		using NativeIntegerResult = std::enable_if_t<isNativeInteger<Integer>::value, Result>;
+
+		//A built-in integer as a sign and a magnitude of up to two limbs, so that every integer type can share the same few routines.
+		struct NativeInteger {
+			std::uint64_t low;
+			std::uint64_t high;
+			bool negative;
+		};
+
+		template<typename Integer>
+		constexpr NativeInteger splitInteger(Integer value) {
+#if defined(__SIZEOF_INT128__)
+			using Widest = unsigned __int128;
+#else
+			using Widest = std::uint64_t;
+#endif
+			//Converting to the widest unsigned type sign-extends, and negating that gives the magnitude, even of the most negative value of the type.
+			bool negative{ false };
+			Widest magnitude{ static_cast<Widest>(value) };
+			if constexpr (static_cast<Integer>(-1) < static_cast<Integer>(0)) {
+				if (value < 0) {
+					negative = true;
+					magnitude = 0 - magnitude;
+				}
+			}
+#if defined(__SIZEOF_INT128__)
+			return { static_cast<std::uint64_t>(magnitude), static_cast<std::uint64_t>(magnitude >> 64), negative };
+#else
+			return { magnitude, 0, negative };
+#endif
+		}
+	}
+
+	//The order in which BigInt's exportBytes and importBytes lay out the bytes of a magnitude.
+	enum class ByteOrder {
+		little,	//Least significant byte first.
+		big		//Most significant byte first, as in network order.
+	};
+
 	class BigInt
 	{
+		//FixedInt converts to and from BigInt by copying limbs directly.
+		template<std::size_t Bits>
+		friend class FixedInt;
+		//As does MontgomeryContext, which works on the raw limbs throughout.
+		friend class MontgomeryContext;
+
 	public:
 		//The type used should hopefully not change and this alias is largely a stayover from testing, however some specific cases may require it to be changed.
 		using arrayType = uint64_t;
+		//Limbs beyond the inline few come from a std::pmr::memory_resource, following the same rules as the std::pmr containers: the allocator is fixed
+		//at construction, moves carry it with them, copies and the results of operators use the default resource, and assignment never changes it.
+		//So a computation can be backed by an arena either by constructing its working values with the arena's allocator and updating them with
+		//the compound assignment operators, which reuse their left operand's storage, or by making the arena the default resource for its duration.
+		//Scratch space kept between operations always comes from new and delete, so none of it is ever taken from, or handed to, the caller's resource.
+		using allocator_type = std::pmr::polymorphic_allocator<arrayType>;
+		//The storage of a BigInt's limbs, which can be filled directly and then handed over to the BigInt constructor without being copied.
+		using LimbBuffer = detail::LimbBuffer;
 
 
 	private:
 
 		bool						m_sign;		//The sign. True = positive, false = negative
-		std::vector<arrayType>		m_bits;		//The data structure which contains our number's value. We use fixed-width unsigned intergers as bit collections to represent a larger number.
+		detail::LimbBuffer			m_bits;		//The data structure which contains our number's value. We use fixed-width unsigned intergers as bit collections to represent a larger number.
+		//Small values are held inline within the BigInt itself, so only numbers of more than a few limbs allocate.
 		//The array is "little endian" in that the index of 0 represents the least significant term.
 
 		static constexpr arrayType	unitSize{ 8 * sizeof(arrayType) };					//As we can hypothetically use any unsigned integer type for this object, we define these constants to represent that type's limits.
@@ -53,15 +157,37 @@ namespace dp {
 		//Ditto for the nth bit of the composite bit array.
 		void setTotalNthBit(std::size_t inIndex, bool inBit);
 
+		//Addition and subtraction share the same code, as subtracting is adding with the sign of rhs flipped. Only one magnitude comparison is ever made.
+		//This works on the limbs of this BigInt in place, so m_bits only grows when the result outgrows its capacity.
+		void addInPlace(const BigInt& rhs, bool negateRhs);
+
+		//The routines behind the operators which take built-in integers. Values which fit in one limb work directly on m_bits, and those which
+		//need two are made into a BigInt (which holds them inline, without allocating) and passed to the BigInt operators.
+		void assignNative(const detail::NativeInteger& value);
+		void addNative(const detail::NativeInteger& value, bool negate);
+		void multiplyNative(const detail::NativeInteger& value);
+		void divideNative(const detail::NativeInteger& value, bool returnRemainder);
+		int compareNative(const detail::NativeInteger& value) const;
+
+		//Sets solution to a | b or a ^ b, according to op: the operation is applied over the shorter operand's limbs, and the rest of the longer is copied.
+		static void combineUnequal(BigInt& solution, const BigInt& a, const BigInt& b, void (*op)(arrayType*, const arrayType*, const arrayType*, std::size_t));
+
+		//Sets this BigInt to the signed sum of the terms, each a number or a product of two. The products are formed in scratch space and then every
+		//term is added in one pass over the limbs, with a single running carry, straight into m_bits. Terms may refer to this BigInt itself.
+		void assignSum(const detail::SumTerm* terms, std::size_t count);
+
 		//As division and modulo use essentially the same algorithm, they share the underlying code here.
 		void divide(const BigInt& dividend, const BigInt& divisor, BigInt& solution, bool returnRemainder) const;
 
+		//Divide the magnitude of this BigInt in place by a single limb, in a single pass. Returns the remainder.
+		arrayType divideMagnitude(arrayType divisor);
+		arrayType divideMagnitude(const InvariantDivisor& divisor);
+
 		/*
 		* REPRESENTATION FUNCTIONS
 		*/
-		//Used to get a string representing the total number
-		std::string getBinaryString() const;
-		std::string getDecimalString() const;
+		//Parses an unsigned run of digits in the given base, as for fromChars.
+		static std::from_chars_result parseMagnitude(const char* first, const char* last, BigInt& value, int base);
 
 
 	public:
@@ -71,8 +197,28 @@ namespace dp {
 		BigInt();
 		BigInt(const BigInt&) = default;
 		BigInt(BigInt&&) noexcept = default;
-		BigInt(const std::string& inNumber);			//Currently unimplemented pending a better algorithm for converting between bases 10 and 2.
+		explicit BigInt(const allocator_type& alloc);
+		BigInt(const BigInt& inInt, const allocator_type& alloc);
+		BigInt(BigInt&& inInt, const allocator_type& alloc);
+		//Parses an optionally signed integer, in hexadecimal if prefixed with 0x, binary if prefixed with 0b, and decimal otherwise.
+		//Throws std::invalid_argument if the whole string is not a valid integer.
+		BigInt(std::string_view inNumber);
+		BigInt(std::string_view inNumber, const allocator_type& alloc);
+		//std::string needs two conversions to reach the string_view constructor, which is one too many for copy-initialisation, so it has its own.
+		//This is a template only so that string literals, and the 0 in BigInt{ 0 }, don't find it ambiguous with the constructors either side.
+		template<typename String, typename = std::enable_if_t<std::is_same_v<String, std::string>>>
+		BigInt(const String& inNumber) : BigInt{ std::string_view{ inNumber } } {}
 		BigInt(arrayType inVal, bool sign = true);
+		BigInt(arrayType inVal, bool sign, const allocator_type& alloc);
+		//Takes over the given limbs, least significant first, as the magnitude. A buffer on the heap is adopted as it stands rather than copied, and keeps
+		//its memory resource. Leading zero limbs are trimmed, and an empty buffer is zero.
+		explicit BigInt(LimbBuffer&& inLimbs, bool sign = true);
+		//Any other built-in integer, keeping its sign, including __int128. This is a template so that it is an exact match for every integer type,
+		//which keeps small literals such as BigInt{ -1 } from being ambiguous with (or narrowed by) the arrayType constructor.
+		template<typename Integer, typename = detail::NativeIntegerResult<Integer, void>>
+		BigInt(Integer inVal) : BigInt{} {
+			assignNative(detail::splitInteger(inVal));
+		}
 
 
 		virtual ~BigInt() = default;
@@ -86,15 +232,58 @@ namespace dp {
 		BigInt operator*(const BigInt& inInt) const;
 		BigInt operator/(const BigInt& inInt) const;
 		BigInt operator%(const BigInt& inInt) const;
+		//Single-limb divisors skip the general long division entirely.
+		BigInt operator/(arrayType inDivisor) const;
+		BigInt operator%(arrayType inDivisor) const;
+		BigInt operator/(const InvariantDivisor& inDivisor) const;
+		BigInt operator%(const InvariantDivisor& inDivisor) const;
 		BigInt& operator++();
 		BigInt operator++(int);
 		BigInt& operator--();
 		BigInt operator--(int);
 
+		//The square of this number. Each cross product of limbs is only formed once and then doubled, which makes this markedly cheaper than a general
+		//multiplication. x * x and x *= x are recognised as squares and take the same path.
+		BigInt square() const;
+
 		//We provide friend function variants of these operators to preserve commutivity with non-BigInt integer types.
 		friend BigInt operator+(arrayType inUInt, const BigInt& inInt);
 		friend BigInt operator*(arrayType inUInt, const BigInt& inInt);
 
+		//Division which returns both the quotient and the remainder from a single pass, as {quotient, remainder}.
+		friend std::pair<BigInt, BigInt> divmod(const BigInt& dividend, const BigInt& divisor);
+		friend std::pair<BigInt, BigInt> divmod(const BigInt& dividend, arrayType divisor);
+		friend std::pair<BigInt, BigInt> divmod(const BigInt& dividend, const InvariantDivisor& divisor);
+
+		//base^exponent by sliding-window exponentiation, squaring with the dedicated squaring kernel. 0^0 is taken to be 1. Throws std::length_error
+		//if the result would have more bits than a std::size_t can count.
+		friend BigInt pow(const BigInt& base, std::uint64_t exponent);
+		//base^exponent mod |modulus|, in [0, |modulus|). Odd moduli are handled by Montgomery multiplication and even ones by Barrett reduction, so
+		//neither takes a long division per step. A modulus of 0, or a negative exponent, throws std::invalid_argument.
+		friend BigInt powmod(const BigInt& base, const BigInt& exponent, const BigInt& modulus);
+
+		//Fused multiply-add, acc += a * b. For operands in the schoolbook range each row of the product is accumulated straight into acc, so the product
+		//itself is never formed and acc's storage is reused. Larger operands, or an acc which aliases a or b, fall back to forming the product first.
+		friend void addmul(BigInt& acc, const BigInt& a, const BigInt& b);
+
+		//The greatest common divisor of a and b, which is never negative. gcd(0, 0) is 0. Uses Lehmer's algorithm, so most of the work is done on
+		//single limbs taken from the front of each number rather than by long division.
+		friend BigInt gcd(const BigInt& a, const BigInt& b);
+		//The least common multiple of a and b, which is never negative, and is 0 if either of them is.
+		friend BigInt lcm(const BigInt& a, const BigInt& b);
+		//{g, x, y} such that g = gcd(a, b) and a*x + b*y = g. The coefficients are those of Euclid's algorithm, so are no larger than |b| and |a| respectively.
+		friend std::tuple<BigInt, BigInt, BigInt> gcdExtended(const BigInt& a, const BigInt& b);
+		//The inverse of a modulo |modulus|, in [0, |modulus|). Throws std::invalid_argument if the modulus is 0 or a and the modulus are not coprime.
+		friend BigInt modInverse(const BigInt& a, const BigInt& modulus);
+
+		//floor(sqrt(x)). A negative x throws std::invalid_argument.
+		friend BigInt isqrt(const BigInt& x);
+		//The n-th root of x, rounded towards zero. Negative values have odd roots taken of their magnitude and negated, but an even root of one, or
+		//n = 0, throws std::invalid_argument.
+		friend BigInt iroot(const BigInt& x, std::uint64_t n);
+		//Whether x is the square of an integer. Most non-squares are rejected by their residues to a few small moduli before any root is taken.
+		friend bool isPerfectSquare(const BigInt& x);
+
 		/*
 		* COMPARISON OPERATORS
 		*/
@@ -120,33 +309,207 @@ namespace dp {
 		//Expanding Left Shift. This operates as a bitwise << operator, except it will expand the range of the BigInt to fit the equation rather than truncating off any overflow.
 		BigInt xLS(arrayType inInt) const;
 
+		/*
+		* BIT ACCESS
+		*/
+		//All of these act on the magnitude and ignore the sign, so -6 has the same bits as 6. None of them scan more than the limbs they need.
+		//The number of bits up to and including the highest set bit, which is 0 for zero.
+		std::size_t bitLength() const;
+		//The number of set bits.
+		std::size_t popcount() const;
+		//The index of the lowest set bit, which is also the number of times 2 divides the number. Zero has no set bits, and gives std::numeric_limits<std::size_t>::max().
+		std::size_t lowestSetBit() const;
+		//Whether bit n is set. Every bit from bitLength() upwards is clear.
+		bool testBit(std::size_t n) const;
+		//Sets bit n to value, growing the number if need be.
+		void setBit(std::size_t n, bool value = true);
+		//The limbs of the magnitude, least significant first, with no leading zero limbs (so zero is a single zero limb). This refers to the BigInt's own
+		//storage, and is only valid until the BigInt is next changed.
+		const detail::LimbBuffer& limbs() const;
+		//Hands over the limbs of the magnitude without copying them, in the same form as limbs(), and leaves this BigInt as zero.
+		LimbBuffer releaseLimbs();
+
+
+		/*
+		* BINARY SERIALISATION
+		*/
+		//As with the bit access functions, exportBytes and importBytes deal only in the magnitude, in the manner of GMP's mpz_export and mpz_import.
+		//The number of bytes in the magnitude with no leading zero bytes, which is 0 for zero.
+		std::size_t byteLength() const;
+		//Writes the byteLength() bytes of the magnitude to out, and returns a pointer past the last of them.
+		std::uint8_t* exportBytes(std::uint8_t* out, ByteOrder order = ByteOrder::big) const;
+		std::vector<std::uint8_t> exportBytes(ByteOrder order = ByteOrder::big) const;
+		//The non-negative number held in size bytes. Leading zero bytes are allowed.
+		static BigInt importBytes(const std::uint8_t* data, std::size_t size, ByteOrder order = ByteOrder::big);
+
+		//A compact self-delimiting format for storage and exchange: an unsigned LEB128 varint holding byteLength() * 2 + 1 if negative (or + 0 if not),
+		//followed by the magnitude's bytes least significant first. Numbers below 2^56 take at most eight bytes in all.
+		std::size_t serialisedSize() const;
+		//Writes serialisedSize() bytes to out, and returns a pointer past the last of them.
+		std::uint8_t* serialise(std::uint8_t* out) const;
+		std::vector<std::uint8_t> serialise() const;
+		//Reads one number written by serialise from the start of [first, last) into value, reusing value's storage, and returns a pointer past it.
+		//If the range is truncated or the header is malformed, nullptr is returned and value is left untouched. This never throws, barring allocation.
+		static const std::uint8_t* deserialise(const std::uint8_t* first, const std::uint8_t* last, BigInt& value);
+
 
 		/*
 		* ASSIGNMENT OPERATORS
 		*/
 		BigInt& operator=(const BigInt&) = default;
-		BigInt& operator=(BigInt&& inInt) noexcept = default;
+		//Not noexcept, as moving between BigInts with different memory resources has to copy the limbs.
+		BigInt& operator=(BigInt&& inInt) = default;
 		BigInt& operator+=(const BigInt& inInt);
 		BigInt& operator-=(const BigInt& inInt);
 		BigInt& operator*=(const BigInt& inInt);
 		BigInt& operator/=(const BigInt& inInt);
 		BigInt& operator%=(const BigInt& inInt);
+		BigInt& operator/=(arrayType inDivisor);
+		BigInt& operator%=(arrayType inDivisor);
 		BigInt& operator<<=(arrayType inInt);
 		BigInt& operator>>=(arrayType inInt);
 		BigInt& operator&=(const BigInt& inInt);
 		BigInt& operator|=(const BigInt& inInt);
 		BigInt& operator^=(const BigInt& inInt);
+		//Evaluate a deferred expression from BigIntExpr.h, reusing this BigInt's storage for the result.
+		template<typename Expression>
+		BigInt& operator=(const BigIntExpr<Expression>& expression);
+		template<typename Expression>
+		BigInt& operator+=(const BigIntExpr<Expression>& expression);
+		template<typename Expression>
+		BigInt& operator-=(const BigIntExpr<Expression>& expression);
+
+		/*
+		* NATIVE INTEGER OPERATORS
+		*/
+		//Arithmetic and comparison with any built-in integer, signed or not, without first making a BigInt of it. A value which fits in one limb
+		//works directly on this number's limbs, so none of these allocate unless the result outgrows its storage. As for the built-in types, division
+		//truncates towards zero and the remainder takes the sign of the dividend.
+		template<typename Integer>
+		detail::NativeIntegerResult<Integer, BigInt&> operator+=(Integer inVal) {
+			addNative(detail::splitInteger(inVal), false);
+			return *this;
+		}
+		template<typename Integer>
+		detail::NativeIntegerResult<Integer, BigInt&> operator-=(Integer inVal) {
+			addNative(detail::splitInteger(inVal), true);
+			return *this;
+		}
+		template<typename Integer>
+		detail::NativeIntegerResult<Integer, BigInt&> operator*=(Integer inVal) {
+			multiplyNative(detail::splitInteger(inVal));
+			return *this;
+		}
+		template<typename Integer>
+		detail::NativeIntegerResult<Integer, BigInt&> operator/=(Integer inVal) {
+			divideNative(detail::splitInteger(inVal), false);
+			return *this;
+		}
+		template<typename Integer>
+		detail::NativeIntegerResult<Integer, BigInt&> operator%=(Integer inVal) {
+			divideNative(detail::splitInteger(inVal), true);
+			return *this;
+		}
+
+		template<typename Integer>
+		detail::NativeIntegerResult<Integer, BigInt> operator+(Integer inVal) const {
+			BigInt solution{ *this };
+			solution += inVal;
+			return solution;
+		}
+		template<typename Integer>
+		detail::NativeIntegerResult<Integer, BigInt> operator-(Integer inVal) const {
+			BigInt solution{ *this };
+			solution -= inVal;
+			return solution;
+		}
+		template<typename Integer>
+		detail::NativeIntegerResult<Integer, BigInt> operator*(Integer inVal) const {
+			BigInt solution{ *this };
+			solution *= inVal;
+			return solution;
+		}
+		template<typename Integer>
+		detail::NativeIntegerResult<Integer, BigInt> operator/(Integer inVal) const {
+			BigInt solution{ *this };
+			solution /= inVal;
+			return solution;
+		}
+		template<typename Integer>
+		detail::NativeIntegerResult<Integer, BigInt> operator%(Integer inVal) const {
+			BigInt solution{ *this };
+			solution %= inVal;
+			return solution;
+		}
+
+		template<typename Integer>
+		detail::NativeIntegerResult<Integer, bool> operator==(Integer inVal) const { return compareNative(detail::splitInteger(inVal)) == 0; }
+		template<typename Integer>
+		detail::NativeIntegerResult<Integer, bool> operator!=(Integer inVal) const { return compareNative(detail::splitInteger(inVal)) != 0; }
+		template<typename Integer>
+		detail::NativeIntegerResult<Integer, bool> operator<(Integer inVal) const { return compareNative(detail::splitInteger(inVal)) < 0; }
+		template<typename Integer>
+		detail::NativeIntegerResult<Integer, bool> operator<=(Integer inVal) const { return compareNative(detail::splitInteger(inVal)) <= 0; }
+		template<typename Integer>
+		detail::NativeIntegerResult<Integer, bool> operator>(Integer inVal) const { return compareNative(detail::splitInteger(inVal)) > 0; }
+		template<typename Integer>
+		detail::NativeIntegerResult<Integer, bool> operator>=(Integer inVal) const { return compareNative(detail::splitInteger(inVal)) >= 0; }
+
+		//The same with the built-in integer on the left. The comparisons go straight to compareNative, as in C++20 rhs == lhs could otherwise
+		//resolve back to the reversed form of this same function.
+		template<typename Integer>
+		friend detail::NativeIntegerResult<Integer, BigInt> operator+(Integer lhs, const BigInt& rhs) { return rhs + lhs; }
+		template<typename Integer>
+		friend detail::NativeIntegerResult<Integer, BigInt> operator-(Integer lhs, const BigInt& rhs) {
+			BigInt solution{ -rhs };
+			solution += lhs;
+			return solution;
+		}
+		template<typename Integer>
+		friend detail::NativeIntegerResult<Integer, BigInt> operator*(Integer lhs, const BigInt& rhs) { return rhs * lhs; }
+		template<typename Integer>
+		friend detail::NativeIntegerResult<Integer, BigInt> operator/(Integer lhs, const BigInt& rhs) { return BigInt{ lhs } / rhs; }
+		template<typename Integer>
+		friend detail::NativeIntegerResult<Integer, BigInt> operator%(Integer lhs, const BigInt& rhs) { return BigInt{ lhs } % rhs; }
+
+		template<typename Integer>
+		friend detail::NativeIntegerResult<Integer, bool> operator==(Integer lhs, const BigInt& rhs) { return rhs.compareNative(detail::splitInteger(lhs)) == 0; }
+		template<typename Integer>
+		friend detail::NativeIntegerResult<Integer, bool> operator!=(Integer lhs, const BigInt& rhs) { return rhs.compareNative(detail::splitInteger(lhs)) != 0; }
+		template<typename Integer>
+		friend detail::NativeIntegerResult<Integer, bool> operator<(Integer lhs, const BigInt& rhs) { return rhs.compareNative(detail::splitInteger(lhs)) > 0; }
+		template<typename Integer>
+		friend detail::NativeIntegerResult<Integer, bool> operator<=(Integer lhs, const BigInt& rhs) { return rhs.compareNative(detail::splitInteger(lhs)) >= 0; }
+		template<typename Integer>
+		friend detail::NativeIntegerResult<Integer, bool> operator>(Integer lhs, const BigInt& rhs) { return rhs.compareNative(detail::splitInteger(lhs)) < 0; }
+		template<typename Integer>
+		friend detail::NativeIntegerResult<Integer, bool> operator>=(Integer lhs, const BigInt& rhs) { return rhs.compareNative(detail::splitInteger(lhs)) <= 0; }
 
 
 		/*
 		* MISC FUNCTIONALITY
 		*/
 		bool sign() const;
+		allocator_type get_allocator() const;
 		BigInt abs() const;
 		//Determines if a BigInt can be safely cast to the arrayType without losing value.
 		bool canBeShortened() const;
 		explicit operator arrayType() const;
+		//The number as written by toChars. Throws std::invalid_argument for any base other than 2, 10 or 16.
 		std::string toString(int base = 10) const;
+		//Writes the number into the caller's range [first, last) in the manner of std::to_chars, with no leading zeroes and a leading '-' if negative.
+		//Bases 2, 10 and 16 are supported; any other base gives std::errc::invalid_argument. If the range is too small, std::errc::value_too_large is
+		//returned along with last, and the contents of the range are unspecified.
+		std::to_chars_result toChars(char* first, char* last, int base = 10) const;
+		//The inverse of toChars, in the manner of std::from_chars. Parses an optional '-' followed by as many digits of the given base (2, 10 or 16) as
+		//possible from [first, last), and returns a pointer past the last one used. If there are no digits, std::errc::invalid_argument is returned and
+		//value is left untouched. This never throws, so is better suited than the string constructor to hot parsing loops.
+		static std::from_chars_result fromChars(const char* first, const char* last, BigInt& value, int base = 10);
+
+		//The number of threads which one multiplication, and so anything built on multiplication such as division and powers, may use once both
+		//operands reach DP_BIGINT_PARALLEL_THRESHOLD limbs. The default of 1 keeps everything on the calling thread, and 0 allows one per hardware thread.
+		static void setMultiplyThreads(unsigned count);
+		static unsigned multiplyThreads();
 
 
 
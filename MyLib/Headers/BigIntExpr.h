@@ -0,0 +1,228 @@
+#ifndef BIGINTEXPR
+#define BIGINTEXPR
+
+/*
+* Deferred evaluation of BigInt arithmetic. Wrapping a number in dp::lazy() makes the arithmetic built on it produce a small expression object rather
+* than a result, and nothing is computed until that expression is assigned to a BigInt:
+*
+*     result = dp::lazy(a) * b + dp::lazy(c) * d - e;
+*
+* The whole right-hand side is then evaluated as one signed sum of terms, each either a number or a product of two. The products are formed in
+* scratch space, and all of the terms are added in a single pass over their limbs into result's existing storage, so no intermediate BigInt is ever
+* created. Anything which doesn't fit that shape, such as (a + b) * c, has its inner sum evaluated when the expression is built.
+* Expressions refer to their operands rather than copying them, so should be assigned in the statement that builds them and never stored with auto.
+*/
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+#include "BigInt.h"
+
+namespace dp {
+
+	namespace detail {
+
+		//One term of a sum: left, or left * right if right is not null, added if negative is false and subtracted otherwise.
+		struct SumTerm {
+			const BigInt* left;
+			const BigInt* right;
+			bool negative;
+		};
+
+	}
+
+	//The base of every deferred expression. Each one reports how many terms it contributes to the sum and writes them out with collect.
+	template<typename Expression>
+	class BigIntExpr
+	{
+	public:
+		const Expression& self() const {
+			return static_cast<const Expression&>(*this);
+		}
+
+		//Evaluating into a new BigInt, for when the result has nowhere to go already.
+		operator BigInt() const {
+			BigInt result;
+			result = *this;
+			return result;
+		}
+	};
+
+	namespace detail {
+
+		class LazyBigInt : public BigIntExpr<LazyBigInt>
+		{
+			const BigInt& m_value;
+
+		public:
+			static constexpr std::size_t termCount{ 1 };
+
+			explicit LazyBigInt(const BigInt& value) : m_value{ value } {}
+
+			const BigInt& value() const {
+				return m_value;
+			}
+
+			void collect(SumTerm* terms, bool negative) const {
+				terms[0] = SumTerm{ &m_value, nullptr, negative };
+			}
+		};
+
+		//One side of a product. A plain number is referred to where it is, but anything else has to be evaluated first, and the result is kept here.
+		class ProductOperand
+		{
+			BigInt m_owned;
+			const BigInt* m_referenced{ nullptr };
+
+		public:
+			explicit ProductOperand(const BigInt& value) : m_referenced{ &value } {}
+			explicit ProductOperand(const LazyBigInt& value) : m_referenced{ &value.value() } {}
+			template<typename Expression>
+			explicit ProductOperand(const BigIntExpr<Expression>& expression) : m_owned{ BigInt(expression) } {}
+
+			const BigInt& value() const {
+				return m_referenced ? *m_referenced : m_owned;
+			}
+		};
+
+		class LazyProduct : public BigIntExpr<LazyProduct>
+		{
+			ProductOperand m_left;
+			ProductOperand m_right;
+
+		public:
+			static constexpr std::size_t termCount{ 1 };
+
+			LazyProduct(ProductOperand left, ProductOperand right) : m_left{ std::move(left) }, m_right{ std::move(right) } {}
+
+			void collect(SumTerm* terms, bool negative) const {
+				terms[0] = SumTerm{ &m_left.value(), &m_right.value(), negative };
+			}
+		};
+
+		template<typename Left, typename Right, bool Subtract>
+		class LazySum : public BigIntExpr<LazySum<Left, Right, Subtract>>
+		{
+			Left m_left;
+			Right m_right;
+
+		public:
+			static constexpr std::size_t termCount{ Left::termCount + Right::termCount };
+
+			LazySum(const Left& left, const Right& right) : m_left{ left }, m_right{ right } {}
+
+			void collect(SumTerm* terms, bool negative) const {
+				m_left.collect(terms, negative);
+				m_right.collect(terms + Left::termCount, negative != Subtract);
+			}
+		};
+
+		template<typename Operand>
+		class LazyNegation : public BigIntExpr<LazyNegation<Operand>>
+		{
+			Operand m_operand;
+
+		public:
+			static constexpr std::size_t termCount{ Operand::termCount };
+
+			explicit LazyNegation(const Operand& operand) : m_operand{ operand } {}
+
+			void collect(SumTerm* terms, bool negative) const {
+				m_operand.collect(terms, !negative);
+			}
+		};
+
+	}
+
+	//The entry point to deferred evaluation: arithmetic on the result builds an expression rather than a BigInt.
+	inline detail::LazyBigInt lazy(const BigInt& value) {
+		return detail::LazyBigInt{ value };
+	}
+
+	/*
+	* ARITHMETIC OPERATORS
+	*/
+	template<typename Left, typename Right>
+	detail::LazySum<Left, Right, false> operator+(const BigIntExpr<Left>& left, const BigIntExpr<Right>& right) {
+		return { left.self(), right.self() };
+	}
+
+	template<typename Left>
+	detail::LazySum<Left, detail::LazyBigInt, false> operator+(const BigIntExpr<Left>& left, const BigInt& right) {
+		return { left.self(), detail::LazyBigInt{ right } };
+	}
+
+	template<typename Right>
+	detail::LazySum<detail::LazyBigInt, Right, false> operator+(const BigInt& left, const BigIntExpr<Right>& right) {
+		return { detail::LazyBigInt{ left }, right.self() };
+	}
+
+	template<typename Left, typename Right>
+	detail::LazySum<Left, Right, true> operator-(const BigIntExpr<Left>& left, const BigIntExpr<Right>& right) {
+		return { left.self(), right.self() };
+	}
+
+	template<typename Left>
+	detail::LazySum<Left, detail::LazyBigInt, true> operator-(const BigIntExpr<Left>& left, const BigInt& right) {
+		return { left.self(), detail::LazyBigInt{ right } };
+	}
+
+	template<typename Right>
+	detail::LazySum<detail::LazyBigInt, Right, true> operator-(const BigInt& left, const BigIntExpr<Right>& right) {
+		return { detail::LazyBigInt{ left }, right.self() };
+	}
+
+	template<typename Operand>
+	detail::LazyNegation<Operand> operator-(const BigIntExpr<Operand>& operand) {
+		return detail::LazyNegation<Operand>{ operand.self() };
+	}
+
+	template<typename Left, typename Right>
+	detail::LazyProduct operator*(const BigIntExpr<Left>& left, const BigIntExpr<Right>& right) {
+		return { detail::ProductOperand{ left.self() }, detail::ProductOperand{ right.self() } };
+	}
+
+	template<typename Left>
+	detail::LazyProduct operator*(const BigIntExpr<Left>& left, const BigInt& right) {
+		return { detail::ProductOperand{ left.self() }, detail::ProductOperand{ right } };
+	}
+
+	template<typename Right>
+	detail::LazyProduct operator*(const BigInt& left, const BigIntExpr<Right>& right) {
+		return { detail::ProductOperand{ left }, detail::ProductOperand{ right.self() } };
+	}
+
+	/*
+	* EVALUATION
+	*/
+	template<typename Expression>
+	BigInt& BigInt::operator=(const BigIntExpr<Expression>& expression) {
+		std::array<detail::SumTerm, Expression::termCount> terms;
+		expression.self().collect(terms.data(), false);
+		assignSum(terms.data(), terms.size());
+		return *this;
+	}
+
+	//The compound forms just add this BigInt to the sum as one more term.
+	template<typename Expression>
+	BigInt& BigInt::operator+=(const BigIntExpr<Expression>& expression) {
+		std::array<detail::SumTerm, Expression::termCount + 1> terms;
+		terms[0] = detail::SumTerm{ this, nullptr, false };
+		expression.self().collect(terms.data() + 1, false);
+		assignSum(terms.data(), terms.size());
+		return *this;
+	}
+
+	template<typename Expression>
+	BigInt& BigInt::operator-=(const BigIntExpr<Expression>& expression) {
+		std::array<detail::SumTerm, Expression::termCount + 1> terms;
+		terms[0] = detail::SumTerm{ this, nullptr, false };
+		expression.self().collect(terms.data() + 1, true);
+		assignSum(terms.data(), terms.size());
+		return *this;
+	}
+
+}
+
+#endif
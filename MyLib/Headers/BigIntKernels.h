@@ -0,0 +1,438 @@
+#ifndef BIGINTKERNELS
+#define BIGINTKERNELS
+
+/*
+* Low-level "limb" routines which underpin the BigInt class.
+* Each routine works on raw little-endian arrays of 64-bit unsigned integers (limbs) rather than on BigInt objects, so that the arithmetic can be written as
+* tight loops over preallocated memory without the copying and reallocation that the BigInt operators would otherwise incur. Other than the scratch
+* space used by the subquadratic multiplication and division algorithms none of these routines allocate, and none of them know anything about signs; that is left to the BigInt class.
+* These are implementation details of BigInt and not intended to be called directly by users of the library.
+*/
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+//The operand sizes (in limbs) at which multiplication switches from schoolbook to Karatsuba, and from Karatsuba to Toom-Cook 3-way.
+//The best values depend on the host CPU, so these can be overridden at build time by defining them (e.g. /D or -D) before this header is seen.
+#ifndef DP_BIGINT_KARATSUBA_THRESHOLD
+#define DP_BIGINT_KARATSUBA_THRESHOLD 24
+#endif
+
+#ifndef DP_BIGINT_TOOM3_THRESHOLD
+#define DP_BIGINT_TOOM3_THRESHOLD 256
+#endif
+
+//The size of the smaller operand (in limbs) above which multiplication is done by number-theoretic transform.
+#ifndef DP_BIGINT_NTT_THRESHOLD
+#define DP_BIGINT_NTT_THRESHOLD 7168
+#endif
+
+//The size of the smaller operand (in limbs) from which a multiplication may be split across threads, if more than one has been allowed.
+#ifndef DP_BIGINT_PARALLEL_THRESHOLD
+#define DP_BIGINT_PARALLEL_THRESHOLD 4096
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_addcll) && __has_builtin(__builtin_subcll)
+#define DP_BIGINT_HAS_ADDC_BUILTINS
+#endif
+#endif
+
+namespace dp {
+	namespace detail {
+
+		using limb_type = std::uint64_t;
+
+		constexpr std::size_t karatsubaThreshold{ DP_BIGINT_KARATSUBA_THRESHOLD };
+		constexpr std::size_t toom3Threshold{ DP_BIGINT_TOOM3_THRESHOLD };
+		constexpr std::size_t nttThreshold{ DP_BIGINT_NTT_THRESHOLD };
+		constexpr std::size_t parallelThreshold{ DP_BIGINT_PARALLEL_THRESHOLD };
+
+		//The smallest operands the recursive algorithms can split: below these a half or third is too short to hold the carries out of its sums.
+		constexpr std::size_t karatsubaMinimumSize{ 4 };
+		constexpr std::size_t toom3MinimumSize{ 5 };
+
+		//The recursive algorithms need a few limbs per half/third to split into, so very small thresholds are not meaningful.
+		static_assert(karatsubaThreshold >= karatsubaMinimumSize, "DP_BIGINT_KARATSUBA_THRESHOLD must be at least 4 limbs");
+		static_assert(toom3Threshold >= 8, "DP_BIGINT_TOOM3_THRESHOLD must be at least 8 limbs");
+
+		//The number of leading zero bits in a non-zero limb.
+		inline int countLeadingZeros(limb_type x) {
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_clzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+			unsigned long index;
+			_BitScanReverse64(&index, x);
+			return 63 - static_cast<int>(index);
+#else
+			int count{ 0 };
+			for (limb_type mask = static_cast<limb_type>(1) << 63; (x & mask) == 0; mask >>= 1) ++count;
+			return count;
+#endif
+		}
+
+		//The number of trailing zero bits in a non-zero limb.
+		inline int countTrailingZeros(limb_type x) {
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_ctzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+			unsigned long index;
+			_BitScanForward64(&index, x);
+			return static_cast<int>(index);
+#else
+			int count{ 0 };
+			for (limb_type mask = 1; (x & mask) == 0; mask <<= 1) ++count;
+			return count;
+#endif
+		}
+
+		//The number of set bits in a limb.
+		inline int popcount(limb_type x) {
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_popcountll(x);
+#elif defined(_MSC_VER) && defined(_M_X64) && defined(__AVX__)
+			//Every CPU with AVX has the popcnt instruction, which MSVC otherwise can't assume.
+			return static_cast<int>(__popcnt64(x));
+#else
+			x -= (x >> 1) & 0x5555555555555555;
+			x = (x & 0x3333333333333333) + ((x >> 2) & 0x3333333333333333);
+			x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0F;
+			return static_cast<int>((x * 0x0101010101010101) >> 56);
+#endif
+		}
+
+		//Full 64x64->128 bit product of two limbs. The low half is returned and the high half is written to hi.
+		inline limb_type mulWide(limb_type a, limb_type b, limb_type& hi) {
+#if defined(__SIZEOF_INT128__)
+			unsigned __int128 product{ static_cast<unsigned __int128>(a) * b };
+			hi = static_cast<limb_type>(product >> 64);
+			return static_cast<limb_type>(product);
+#elif defined(_MSC_VER) && defined(_M_X64)
+			return _umul128(a, b, &hi);
+#else
+			//Portable fallback - split each limb into 32-bit halves and recombine the four partial products.
+			constexpr limb_type lowMask{ 0xFFFFFFFF };
+			limb_type aLow{ a & lowMask }, aHigh{ a >> 32 };
+			limb_type bLow{ b & lowMask }, bHigh{ b >> 32 };
+
+			limb_type lowLow{ aLow * bLow };
+			limb_type lowHigh{ aLow * bHigh };
+			limb_type highLow{ aHigh * bLow };
+			limb_type highHigh{ aHigh * bHigh };
+
+			limb_type middle{ (lowLow >> 32) + (lowHigh & lowMask) + (highLow & lowMask) };
+			hi = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+			return (middle << 32) | (lowLow & lowMask);
+#endif
+		}
+
+		//a + b + carryIn, writing the low limb to out and returning the carry out. These map onto the add-with-carry instruction where the compiler offers it.
+		inline unsigned char addCarry(unsigned char carryIn, limb_type a, limb_type b, limb_type& out) {
+#if defined(_MSC_VER) && defined(_M_X64)
+			return _addcarry_u64(carryIn, a, b, &out);
+#elif defined(DP_BIGINT_HAS_ADDC_BUILTINS)
+			unsigned long long carryOut;
+			out = __builtin_addcll(a, b, carryIn, &carryOut);
+			return static_cast<unsigned char>(carryOut);
+#elif defined(__x86_64__)
+			unsigned long long sum;
+			unsigned char carryOut{ _addcarry_u64(carryIn, a, b, &sum) };
+			out = sum;
+			return carryOut;
+#else
+			limb_type sum{ a + b };
+			unsigned char carryOut{ sum < a };
+			out = sum + carryIn;
+			return carryOut | (out < sum);
+#endif
+		}
+
+		//a - b - borrowIn, writing the low limb to out and returning the borrow out.
+		inline unsigned char subBorrow(unsigned char borrowIn, limb_type a, limb_type b, limb_type& out) {
+#if defined(_MSC_VER) && defined(_M_X64)
+			return _subborrow_u64(borrowIn, a, b, &out);
+#elif defined(DP_BIGINT_HAS_ADDC_BUILTINS)
+			unsigned long long borrowOut;
+			out = __builtin_subcll(a, b, borrowIn, &borrowOut);
+			return static_cast<unsigned char>(borrowOut);
+#elif defined(__x86_64__)
+			unsigned long long difference;
+			unsigned char borrowOut{ _subborrow_u64(borrowIn, a, b, &difference) };
+			out = difference;
+			return borrowOut;
+#else
+			limb_type difference{ a - b };
+			unsigned char borrowOut{ a < b };
+			out = difference - borrowIn;
+			return borrowOut | (difference < borrowIn);
+#endif
+		}
+
+		//Full 128/64 bit division of high*2^64 + low by divisor, which requires high < divisor so that the quotient fits in one limb.
+		//The quotient is returned and the remainder written to remainder.
+		inline limb_type divWide(limb_type high, limb_type low, limb_type divisor, limb_type& remainder) {
+#if defined(__SIZEOF_INT128__)
+			unsigned __int128 dividend{ (static_cast<unsigned __int128>(high) << 64) | low };
+			limb_type quotient{ static_cast<limb_type>(dividend / divisor) };
+			remainder = low - quotient * divisor;
+			return quotient;
+#elif defined(_MSC_VER) && defined(_M_X64) && _MSC_VER >= 1920
+			return _udiv128(high, low, divisor, &remainder);
+#else
+			//Portable fallback - long division in 32-bit digits, after Hacker's Delight's divlu.
+			constexpr limb_type base{ static_cast<limb_type>(1) << 32 };
+			constexpr limb_type lowMask{ base - 1 };
+			const int shift{ countLeadingZeros(divisor) };
+			divisor <<= shift;
+			const limb_type divisorHigh{ divisor >> 32 };
+			const limb_type divisorLow{ divisor & lowMask };
+			const limb_type numeratorTop{ (high << shift) | (shift == 0 ? 0 : low >> (64 - shift)) };
+			const limb_type numeratorBottom{ low << shift };
+			const limb_type numeratorDigit1{ numeratorBottom >> 32 };
+			const limb_type numeratorDigit0{ numeratorBottom & lowMask };
+
+			limb_type quotient1{ numeratorTop / divisorHigh };
+			limb_type partialRemainder{ numeratorTop - quotient1 * divisorHigh };
+			while (quotient1 >= base || quotient1 * divisorLow > base * partialRemainder + numeratorDigit1) {
+				--quotient1;
+				partialRemainder += divisorHigh;
+				if (partialRemainder >= base) break;
+			}
+			const limb_type middle{ numeratorTop * base + numeratorDigit1 - quotient1 * divisor };
+
+			limb_type quotient0{ middle / divisorHigh };
+			partialRemainder = middle - quotient0 * divisorHigh;
+			while (quotient0 >= base || quotient0 * divisorLow > base * partialRemainder + numeratorDigit0) {
+				--quotient0;
+				partialRemainder += divisorHigh;
+				if (partialRemainder >= base) break;
+			}
+			remainder = (middle * base + numeratorDigit0 - quotient0 * divisor) >> shift;
+			return quotient1 * base + quotient0;
+#endif
+		}
+
+		/*
+		* ADDITION AND SUBTRACTION
+		*/
+		//out[0..n) = a[0..n) + b[0..n). Returns the carry out of the top limb. out may alias either operand.
+		limb_type addSame(limb_type* out, const limb_type* a, const limb_type* b, std::size_t n);
+
+		//out[0..an) = a[0..an) + b[0..bn) for an >= bn. Returns the carry out of the top limb. out may alias either operand.
+		limb_type addUnequal(limb_type* out, const limb_type* a, std::size_t an, const limb_type* b, std::size_t bn);
+
+		//out[0..n) = a[0..n) + b for a single limb b. Returns the carry out of the top limb. out may alias a.
+		limb_type addSingle(limb_type* out, const limb_type* a, std::size_t n, limb_type b);
+
+		//out[0..n) = a[0..n) - b[0..n). Returns the borrow out of the top limb. out may alias either operand.
+		limb_type subSame(limb_type* out, const limb_type* a, const limb_type* b, std::size_t n);
+
+		//out[0..an) = a[0..an) - b[0..bn) for an >= bn. Returns the borrow out of the top limb. out may alias either operand.
+		limb_type subUnequal(limb_type* out, const limb_type* a, std::size_t an, const limb_type* b, std::size_t bn);
+
+		//out[0..n) = a[0..n) - b for a single limb b. Returns the borrow out of the top limb. out may alias a.
+		limb_type subSingle(limb_type* out, const limb_type* a, std::size_t n, limb_type b);
+
+		//Three-way comparison of a[0..an) and b[0..bn), where either may carry leading zero limbs. Returns -1, 0 or 1.
+		int compare(const limb_type* a, std::size_t an, const limb_type* b, std::size_t bn);
+
+		/*
+		* SHIFTS
+		*/
+		//out[0..n) = a[0..n) << shift for 0 < shift < 64. Returns the bits shifted out of the top limb. out may alias a.
+		limb_type shiftLeftBits(limb_type* out, const limb_type* a, std::size_t n, unsigned shift);
+
+		//out[0..n) = a[0..n) >> shift for 0 < shift < 64. Returns the bits shifted out of the bottom limb, in the high bits of the result. out may alias a.
+		limb_type shiftRightBits(limb_type* out, const limb_type* a, std::size_t n, unsigned shift);
+
+		/*
+		* BITWISE OPERATIONS
+		*/
+		//These work a whole vector register at a time when built for AVX2 or AVX-512 (e.g. -mavx2, -march=native or /arch:AVX2), and a limb at
+		//a time otherwise.
+
+		//out[0..n) = a[0..n) & b[0..n), and likewise for | and ^. out may alias either operand.
+		void andSame(limb_type* out, const limb_type* a, const limb_type* b, std::size_t n);
+		void orSame(limb_type* out, const limb_type* a, const limb_type* b, std::size_t n);
+		void xorSame(limb_type* out, const limb_type* a, const limb_type* b, std::size_t n);
+
+		//out[0..n) = ~a[0..n). out may alias a.
+		void complement(limb_type* out, const limb_type* a, std::size_t n);
+
+		//The number of set bits in a[0..n).
+		std::size_t popcount(const limb_type* a, std::size_t n);
+
+		//The number of zero bits below the lowest set bit of a[0..n), or above the highest, which are both 64n if a is zero. Runs of zero limbs
+		//are skipped a vector at a time.
+		std::size_t countTrailingZeros(const limb_type* a, std::size_t n);
+		std::size_t countLeadingZeros(const limb_type* a, std::size_t n);
+
+		/*
+		* MULTIPLICATION
+		*/
+		//out[0..n) = a[0..n) * b. Returns the limb which carries out of the top.
+		limb_type mulSingle(limb_type* out, const limb_type* a, std::size_t n, limb_type b);
+
+		//out[0..n) += a[0..n) * b. Returns the limb which carries out of the top.
+		limb_type addMulSingle(limb_type* out, const limb_type* a, std::size_t n, limb_type b);
+
+		//out[0..n) -= a[0..n) * b. Returns the limb which borrows out of the top.
+		limb_type subMulSingle(limb_type* out, const limb_type* a, std::size_t n, limb_type b);
+
+		//out[0..an+bn) = a[0..an) * b[0..bn) by the schoolbook method. Requires an, bn > 0, and out must not overlap either operand.
+		void mulSchoolbook(limb_type* out, const limb_type* a, std::size_t an, const limb_type* b, std::size_t bn);
+
+		//out[0..2n) = a[0..n) * b[0..n) by Karatsuba's method. Requires n >= karatsubaMinimumSize, and out must not overlap either operand.
+		//mul only calls it from karatsubaThreshold limbs, where it starts to beat schoolbook, but it is correct at any size from the minimum.
+		//If a and b are the same array, the three half-sized products are all squares, and are done as such. Given more than one thread, the three
+		//products are shared between them.
+		void mulKaratsuba(limb_type* out, const limb_type* a, const limb_type* b, std::size_t n, unsigned threads = 1);
+
+		//out[0..2n) = a[0..n) * b[0..n) by Toom-Cook 3-way multiplication. Requires n >= toom3MinimumSize, and out must not overlap either operand.
+		//mul only calls it from toom3Threshold limbs. As with Karatsuba, a and b being the same array makes each of the five pointwise products a square, and they may be shared between threads.
+		void mulToom3(limb_type* out, const limb_type* a, const limb_type* b, std::size_t n, unsigned threads = 1);
+
+		//out[0..an+bn) = a[0..an) * b[0..bn) by number-theoretic transforms over three primes, recombined with the Chinese remainder theorem.
+		//Requires an, bn > 0, and out must not overlap either operand. Squaring (a and b the same array) needs one fewer transform per prime.
+		//Given more than one thread, the primes are worked on at once, and each transform's butterflies and the recombination are divided between them.
+		void mulNtt(limb_type* out, const limb_type* a, std::size_t an, const limb_type* b, std::size_t bn, unsigned threads = 1);
+
+		//out[0..an+bn) = a[0..an) * b[0..bn), picking the fastest algorithm for the operand sizes. Requires an, bn > 0, and out must not overlap either operand.
+		//Squaring is recognised by a and b being the same array of the same length, and then takes the squaring variant of each algorithm.
+		//Once the smaller operand reaches parallelThreshold limbs, the work is split between as many threads as multiplyThreads() allows.
+		void mul(limb_type* out, const limb_type* a, std::size_t an, const limb_type* b, std::size_t bn);
+
+		//As above, but with the number of threads given explicitly. Operands below parallelThreshold limbs are still multiplied on the calling thread.
+		void mul(limb_type* out, const limb_type* a, std::size_t an, const limb_type* b, std::size_t bn, unsigned threads);
+
+		//The number of threads a single large multiplication may use. This is 1 by default, which keeps all multiplication on the calling thread,
+		//and setting it to 0 allows one per hardware thread. It may be changed at any time, and applies to multiplications started after the change.
+		void setMultiplyThreads(unsigned count);
+		unsigned multiplyThreads();
+
+		//out[0..2n) = a[0..n)^2 by the schoolbook method, forming each cross product a[i]*a[j] once and doubling them, for about half the
+		//multiplications of mulSchoolbook. Requires n > 0, and out must not overlap a.
+		void sqrSchoolbook(limb_type* out, const limb_type* a, std::size_t n);
+
+		//out[0..2n) = a[0..n)^2, picking the fastest algorithm for the size. Requires n > 0, and out must not overlap a. Equivalent to mul(out, a, n, a, n).
+		void sqr(limb_type* out, const limb_type* a, std::size_t n);
+
+		/*
+		* EXPONENTIATION
+		*/
+		//The window width for sliding-window exponentiation by an exponent of the given number of bits. Wider windows need fewer multiplications
+		//but a larger table of odd powers, which has 2^(width-1) entries.
+		inline unsigned exponentWindow(std::size_t bits) {
+			if (bits <= 8) return 1;
+			if (bits <= 24) return 2;
+			if (bits <= 80) return 3;
+			if (bits <= 240) return 4;
+			if (bits <= 672) return 5;
+			return 6;
+		}
+
+		//Left-to-right sliding-window exponentiation by e[0..n), driving the caller's accumulator through three callbacks. The first window calls
+		//assign(i) to set the accumulator to base^(2i+1); after that every bit costs a square(), and every later window ends with a multiply(i)
+		//by base^(2i+1). The caller keeps the table of odd powers up to base^(2^window - 1). An exponent of zero calls none of them.
+		template<typename Assign, typename Square, typename Multiply>
+		void slidingWindowExponent(const limb_type* e, std::size_t n, unsigned window, Assign&& assign, Square&& square, Multiply&& multiply) {
+			auto bitAt = [e](std::size_t index) { return static_cast<unsigned>((e[index / 64] >> (index % 64)) & 1); };
+			bool started{ false };
+			std::size_t bit{ 64 * n };
+			while (bit-- > 0) {
+				if (bitAt(bit) == 0) {
+					if (started) square();
+					continue;
+				}
+				//Take the longest run of at most window bits which starts here and ends on a set bit, so that its value is odd.
+				std::size_t length{ (bit + 1 < window) ? bit + 1 : window };
+				while (bitAt(bit + 1 - length) == 0) --length;
+				std::size_t value{ 0 };
+				for (std::size_t i = 0; i < length; ++i) {
+					value = (value << 1) | bitAt(bit - i);
+				}
+				if (started) {
+					for (std::size_t i = 0; i < length; ++i) square();
+					multiply(value >> 1);
+				}
+				else {
+					assign(value >> 1);
+					started = true;
+				}
+				bit -= length - 1;
+			}
+		}
+
+		/*
+		* DIVISION
+		*/
+		//quotient[0..n) = a[0..n) / b, returning a[0..n) % b. Requires b != 0. quotient may alias a, or be null if only the remainder is wanted.
+		limb_type divRemSingle(limb_type* quotient, const limb_type* a, std::size_t n, limb_type b);
+
+		//The reciprocal floor((2^128 - 1) / d) - 2^64 of a normalised (top bit set) divisor d, for use with divRemPreinverted.
+		inline limb_type reciprocalOf(limb_type normalised) {
+			limb_type remainder;
+			return divWide(~normalised, ~static_cast<limb_type>(0), normalised, remainder);
+		}
+
+		//As divRemSingle, but for a divisor given as normalised = divisor << shift together with its reciprocal. Each limb then takes
+		//two multiplications in place of a hardware division.
+		limb_type divRemPreinverted(limb_type* quotient, const limb_type* a, std::size_t n, limb_type normalised, limb_type reciprocal, unsigned shift);
+
+		//Divides a[0..an) by b[0..bn) using Knuth's Algorithm D, writing the quotient to quotient[0..an-bn+1) and the remainder to remainder[0..bn).
+		//Requires an >= bn > 0 and b[bn-1] != 0. Either output may be null if it is not wanted, but neither may overlap the inputs.
+		void divRem(limb_type* quotient, limb_type* remainder, const limb_type* a, std::size_t an, const limb_type* b, std::size_t bn);
+
+		//floor(B^(2n) / d[0..n)), where B = 2^64, which has at most n + 2 limbs. Requires d[n-1] != 0.
+		//Large divisors are handled by Newton iteration, so this costs a handful of n-limb multiplications rather than a quadratic division.
+		std::vector<limb_type> reciprocal(const limb_type* d, std::size_t n);
+
+		//Divides a[0..an) by d[0..dn) with Barrett's method, given mu = reciprocal(d, dn). The quotient is written to quotient[0..an-dn+1) and the
+		//remainder to remainder[0..dn). Requires dn <= an <= 2*dn and d[dn-1] != 0. Either output may be null, but neither may overlap the inputs.
+		//With mu precomputed the division costs two multiplications, which makes this the method of choice for dividing many numbers by the same large divisor.
+		void divRemBarrett(limb_type* quotient, limb_type* remainder, const limb_type* a, std::size_t an, const limb_type* d, std::size_t dn, const std::vector<limb_type>& mu);
+
+		/*
+		* MONTGOMERY REDUCTION
+		*/
+		//-m^-1 mod 2^64 for odd m, the per-limb factor which Montgomery reduction multiplies by.
+		limb_type montgomeryInverse(limb_type m);
+
+		//out[0..n) = t[0..2n) * B^-n mod m[0..n), where B = 2^64 and inverse = montgomeryInverse(m[0]). Requires m odd and t < m * B^n, which
+		//holds for the product of any two values below m; the result is then fully reduced. t is used as working space and its contents destroyed.
+		//out may alias anything but t.
+		void montgomeryReduce(limb_type* out, limb_type* t, const limb_type* m, std::size_t n, limb_type inverse);
+
+		/*
+		* GCD
+		*/
+		//The cosequence matrix of a run of Euclid's algorithm: starting from (u, v), the values Euclid reaches are (a*u + b*v, c*u + d*v).
+		//Along each row one entry is positive and the other negative (or zero), and all are below 2^62 in magnitude.
+		struct LehmerMatrix {
+			std::int64_t a, b, c, d;
+		};
+
+		//One step of Lehmer's algorithm. Runs Euclid's algorithm on the leading 62 bits of u and v for as long as its quotients are sure to match
+		//those of the full values, and returns the matrix of those steps. Requires u >= v, u[un-1] != 0 and un >= vn. If not even one step can be
+		//trusted, b is 0 and the caller has to make progress with a division instead.
+		LehmerMatrix lehmerMatrix(const limb_type* u, std::size_t un, const limb_type* v, std::size_t vn);
+
+		//(u, v) = (m.a*u + m.b*v, m.c*u + m.d*v) for a matrix from lehmerMatrix. Both are n limbs, with v zero-extended if need be, and the results
+		//are again below u. scratch needs 2n + 2 limbs.
+		void lehmerUpdate(limb_type* u, limb_type* v, std::size_t n, const LehmerMatrix& m, limb_type* scratch);
+
+		//out = gcd(a[0..an), b[0..bn)), returning the number of limbs written. Requires both to be non-zero with no leading zero limbs, and out to have
+		//room for min(an, bn) limbs. Lehmer's algorithm brings the values down to two limbs, and a binary GCD held in registers finishes them off.
+		std::size_t gcd(limb_type* out, const limb_type* a, std::size_t an, const limb_type* b, std::size_t bn);
+
+	}
+}
+
+#endif
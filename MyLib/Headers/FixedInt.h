@@ -0,0 +1,402 @@
+#ifndef FIXEDINT
+#define FIXEDINT
+
+/*
+* A fixed-width unsigned integer of Bits bits, for when a number's size is known up front (e.g. 256-bit hashes) and BigInt's sizing, trimming and allocation
+* would be wasted work. The limbs live in a std::array and every loop runs over a compile-time number of them, so the compiler is free to unroll it fully.
+* Arithmetic wraps modulo 2^Bits, exactly as for the built-in unsigned types, and every operation is constexpr.
+* Values convert to and from dp::BigInt; converting a BigInt which doesn't fit keeps its lowest Bits bits, taking negative values as two's complement.
+*/
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+#include "BigInt.h"
+
+namespace dp {
+	namespace detail {
+
+		//Constexpr counterparts of the 64-bit limb helpers in BigIntKernels.h. Those use compiler intrinsics which can't be evaluated at compile time
+		//on every compiler, so these keep to plain arithmetic, with 128-bit integers used where the compiler offers them.
+		constexpr int countLeadingZerosConstexpr(std::uint64_t x) {
+			int count{ 0 };
+			for (int width = 32; width > 0; width /= 2) {
+				if ((x >> (64 - width)) == 0) {
+					count += width;
+					x <<= width;
+				}
+			}
+			return count;
+		}
+
+		constexpr std::uint64_t mulWideConstexpr(std::uint64_t a, std::uint64_t b, std::uint64_t& high) {
+#if defined(__SIZEOF_INT128__)
+			const unsigned __int128 product{ static_cast<unsigned __int128>(a) * b };
+			high = static_cast<std::uint64_t>(product >> 64);
+			return static_cast<std::uint64_t>(product);
+#else
+			constexpr std::uint64_t mask{ 0xFFFFFFFF };
+			const std::uint64_t lowLow{ (a & mask) * (b & mask) };
+			const std::uint64_t lowHigh{ (a & mask) * (b >> 32) };
+			const std::uint64_t highLow{ (a >> 32) * (b & mask) };
+			const std::uint64_t middle{ (lowLow >> 32) + (lowHigh & mask) + (highLow & mask) };
+			high = (a >> 32) * (b >> 32) + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+			return (middle << 32) | (lowLow & mask);
+#endif
+		}
+
+		//high*2^64 + low divided by divisor, for high < divisor.
+		constexpr std::uint64_t divWideConstexpr(std::uint64_t high, std::uint64_t low, std::uint64_t divisor, std::uint64_t& remainder) {
+#if defined(__SIZEOF_INT128__)
+			const unsigned __int128 numerator{ (static_cast<unsigned __int128>(high) << 64) | low };
+			remainder = static_cast<std::uint64_t>(numerator % divisor);
+			return static_cast<std::uint64_t>(numerator / divisor);
+#else
+			//Schoolbook division in base 2^32 by the normalised divisor, as in Hacker's Delight (divlu).
+			constexpr std::uint64_t base{ static_cast<std::uint64_t>(1) << 32 };
+			const int shift{ countLeadingZerosConstexpr(divisor) };
+			divisor <<= shift;
+			const std::uint64_t divisorHigh{ divisor >> 32 };
+			const std::uint64_t divisorLow{ divisor & 0xFFFFFFFF };
+			const std::uint64_t numeratorTop{ (high << shift) | (shift == 0 ? 0 : low >> (64 - shift)) };
+			const std::uint64_t numeratorBottom{ low << shift };
+			const std::uint64_t numeratorDigit1{ numeratorBottom >> 32 };
+			const std::uint64_t numeratorDigit0{ numeratorBottom & 0xFFFFFFFF };
+
+			std::uint64_t quotient1{ numeratorTop / divisorHigh };
+			std::uint64_t estimateRemainder{ numeratorTop - quotient1 * divisorHigh };
+			while (quotient1 >= base || quotient1 * divisorLow > base * estimateRemainder + numeratorDigit1) {
+				--quotient1;
+				estimateRemainder += divisorHigh;
+				if (estimateRemainder >= base) break;
+			}
+			const std::uint64_t middle{ numeratorTop * base + numeratorDigit1 - quotient1 * divisor };
+
+			std::uint64_t quotient0{ middle / divisorHigh };
+			estimateRemainder = middle - quotient0 * divisorHigh;
+			while (quotient0 >= base || quotient0 * divisorLow > base * estimateRemainder + numeratorDigit0) {
+				--quotient0;
+				estimateRemainder += divisorHigh;
+				if (estimateRemainder >= base) break;
+			}
+			remainder = (middle * base + numeratorDigit0 - quotient0 * divisor) >> shift;
+			return quotient1 * base + quotient0;
+#endif
+		}
+	}
+
+	template<std::size_t Bits>
+	class FixedInt
+	{
+		static_assert(Bits > 0 && Bits % 64 == 0, "FixedInt must be a whole number of 64-bit limbs");
+
+	public:
+		using limb_type = std::uint64_t;
+		static constexpr std::size_t limbCount{ Bits / 64 };
+
+	private:
+		std::array<limb_type, limbCount>	m_limbs;	//Little endian, as with BigInt.
+
+		//The number of limbs up to and including the most significant non-zero one.
+		constexpr std::size_t significantLimbs() const {
+			std::size_t count{ limbCount };
+			while (count > 0 && m_limbs[count - 1] == 0) --count;
+			return count;
+		}
+
+		//Knuth's Algorithm D, as used by BigInt, over fixed-size arrays. Either output may be null. Division by zero is UB and gives 0 for both.
+		static constexpr void divide(const FixedInt& dividend, const FixedInt& divisor, FixedInt* quotient, FixedInt* remainder) {
+			FixedInt resultQuotient{};
+			FixedInt resultRemainder{};
+			const std::size_t an{ dividend.significantLimbs() };
+			const std::size_t bn{ divisor.significantLimbs() };
+			if (bn == 0) {
+			}
+			else if (an < bn) {
+				resultRemainder = dividend;
+			}
+			else if (bn == 1) {
+				limb_type carried{ 0 };
+				for (std::size_t i = an; i-- > 0;) {
+					resultQuotient.m_limbs[i] = detail::divWideConstexpr(carried, dividend.m_limbs[i], divisor.m_limbs[0], carried);
+				}
+				resultRemainder.m_limbs[0] = carried;
+			}
+			else {
+				//Normalise so the top bit of the divisor is set. The normalised dividend needs one extra limb and doubles as the running remainder.
+				const int shift{ detail::countLeadingZerosConstexpr(divisor.m_limbs[bn - 1]) };
+				std::array<limb_type, limbCount + 1> u{};
+				std::array<limb_type, limbCount> v{};
+				for (std::size_t i = 0; i < an; ++i) {
+					u[i] |= dividend.m_limbs[i] << shift;
+					if (shift != 0) u[i + 1] = dividend.m_limbs[i] >> (64 - shift);
+				}
+				for (std::size_t i = 0; i < bn; ++i) {
+					v[i] = (divisor.m_limbs[i] << shift) | ((shift != 0 && i > 0) ? divisor.m_limbs[i - 1] >> (64 - shift) : 0);
+				}
+
+				const limb_type divisorTop{ v[bn - 1] };
+				const limb_type divisorNext{ v[bn - 2] };
+				for (std::size_t j = an - bn + 1; j-- > 0;) {
+					limb_type estimate{ 0 };
+					limb_type estimateRemainder{ 0 };
+					bool remainderOverflowed{ false };
+					if (u[j + bn] >= divisorTop) {
+						estimate = ~static_cast<limb_type>(0);
+						estimateRemainder = u[j + bn - 1] + divisorTop;
+						remainderOverflowed = (estimateRemainder < divisorTop);
+					}
+					else {
+						estimate = detail::divWideConstexpr(u[j + bn], u[j + bn - 1], divisorTop, estimateRemainder);
+					}
+					while (!remainderOverflowed) {
+						limb_type productHigh{ 0 };
+						const limb_type productLow{ detail::mulWideConstexpr(estimate, divisorNext, productHigh) };
+						if (productHigh < estimateRemainder || (productHigh == estimateRemainder && productLow <= u[j + bn - 2])) break;
+						--estimate;
+						estimateRemainder += divisorTop;
+						remainderOverflowed = (estimateRemainder < divisorTop);
+					}
+
+					//Subtract estimate * divisor, adding the divisor back in the rare case that the estimate was still one too large.
+					limb_type borrow{ 0 };
+					for (std::size_t i = 0; i < bn; ++i) {
+						limb_type high{ 0 };
+						limb_type low{ detail::mulWideConstexpr(estimate, v[i], high) };
+						low += borrow;
+						high += (low < borrow);
+						const limb_type x{ u[j + i] };
+						u[j + i] = x - low;
+						borrow = high + (x < low);
+					}
+					const limb_type top{ u[j + bn] };
+					u[j + bn] = top - borrow;
+					if (top < borrow) {
+						--estimate;
+						limb_type carry{ 0 };
+						for (std::size_t i = 0; i < bn; ++i) {
+							const limb_type sum{ u[j + i] + carry };
+							carry = (sum < carry);
+							u[j + i] = sum + v[i];
+							carry += (u[j + i] < sum);
+						}
+						u[j + bn] += carry;
+					}
+					resultQuotient.m_limbs[j] = estimate;
+				}
+				for (std::size_t i = 0; i < bn; ++i) {
+					resultRemainder.m_limbs[i] = (u[i] >> shift) | ((shift != 0) ? u[i + 1] << (64 - shift) : 0);
+				}
+			}
+			if (quotient) *quotient = resultQuotient;
+			if (remainder) *remainder = resultRemainder;
+		}
+
+	public:
+		/*
+		* CONSTRUCTORS
+		*/
+		constexpr FixedInt() : m_limbs{} {}
+		constexpr FixedInt(limb_type inVal) : m_limbs{ inVal } {}
+
+		explicit FixedInt(const BigInt& inInt) : m_limbs{} {
+			const std::size_t count{ inInt.m_bits.size() < limbCount ? inInt.m_bits.size() : limbCount };
+			for (std::size_t i = 0; i < count; ++i) {
+				m_limbs[i] = inInt.m_bits[i];
+			}
+			if (!inInt.m_sign) *this = -*this;
+		}
+
+		BigInt toBigInt() const {
+			BigInt solution;
+			solution.m_bits.assign(m_limbs.data(), m_limbs.data() + limbCount);
+			solution.trimLeadingZeroes();
+			return solution;
+		}
+
+		explicit operator BigInt() const {
+			return toBigInt();
+		}
+
+		//The lowest 64 bits.
+		explicit constexpr operator limb_type() const {
+			return m_limbs[0];
+		}
+
+		constexpr limb_type limb(std::size_t index) const {
+			return m_limbs[index];
+		}
+
+		/*
+		* ARITHMETIC OPERATORS
+		*/
+		constexpr FixedInt& operator+=(const FixedInt& inInt) {
+			limb_type carry{ 0 };
+			for (std::size_t i = 0; i < limbCount; ++i) {
+				const limb_type sum{ m_limbs[i] + carry };
+				carry = (sum < carry);
+				m_limbs[i] = sum + inInt.m_limbs[i];
+				carry += (m_limbs[i] < sum);
+			}
+			return *this;
+		}
+
+		constexpr FixedInt& operator-=(const FixedInt& inInt) {
+			limb_type borrow{ 0 };
+			for (std::size_t i = 0; i < limbCount; ++i) {
+				const limb_type x{ m_limbs[i] };
+				const limb_type difference{ x - inInt.m_limbs[i] };
+				m_limbs[i] = difference - borrow;
+				borrow = (x < inInt.m_limbs[i]) + (difference < borrow);
+			}
+			return *this;
+		}
+
+		//Only the product limbs which survive truncation to Bits bits are computed, which is roughly half of the full schoolbook product.
+		constexpr FixedInt& operator*=(const FixedInt& inInt) {
+			FixedInt product{};
+			for (std::size_t i = 0; i < limbCount; ++i) {
+				limb_type carry{ 0 };
+				for (std::size_t j = 0; i + j < limbCount; ++j) {
+					limb_type high{ 0 };
+					limb_type low{ detail::mulWideConstexpr(m_limbs[j], inInt.m_limbs[i], high) };
+					low += carry;
+					high += (low < carry);
+					low += product.m_limbs[i + j];
+					high += (low < product.m_limbs[i + j]);
+					product.m_limbs[i + j] = low;
+					carry = high;
+				}
+			}
+			return *this = product;
+		}
+
+		constexpr FixedInt& operator/=(const FixedInt& inInt) {
+			divide(*this, inInt, this, nullptr);
+			return *this;
+		}
+
+		constexpr FixedInt& operator%=(const FixedInt& inInt) {
+			divide(*this, inInt, nullptr, this);
+			return *this;
+		}
+
+		constexpr FixedInt& operator++() {
+			return *this += FixedInt{ 1 };
+		}
+
+		constexpr FixedInt& operator--() {
+			return *this -= FixedInt{ 1 };
+		}
+
+		constexpr FixedInt operator++(int) {
+			FixedInt copy{ *this };
+			++(*this);
+			return copy;
+		}
+
+		constexpr FixedInt operator--(int) {
+			FixedInt copy{ *this };
+			--(*this);
+			return copy;
+		}
+
+		//Two's complement negation, as for unsigned built-in types.
+		constexpr FixedInt operator-() const {
+			return FixedInt{} - *this;
+		}
+
+		friend constexpr FixedInt operator+(FixedInt lhs, const FixedInt& rhs) { return lhs += rhs; }
+		friend constexpr FixedInt operator-(FixedInt lhs, const FixedInt& rhs) { return lhs -= rhs; }
+		friend constexpr FixedInt operator*(FixedInt lhs, const FixedInt& rhs) { return lhs *= rhs; }
+		friend constexpr FixedInt operator/(FixedInt lhs, const FixedInt& rhs) { return lhs /= rhs; }
+		friend constexpr FixedInt operator%(FixedInt lhs, const FixedInt& rhs) { return lhs %= rhs; }
+
+		/*
+		* BITWISE OPERATORS
+		*/
+		//Unlike the built-in types, shifting by Bits or more is well defined and gives 0.
+		constexpr FixedInt& operator<<=(std::size_t shift) {
+			const std::size_t limbShift{ shift / 64 };
+			const unsigned bitShift{ static_cast<unsigned>(shift % 64) };
+			for (std::size_t i = limbCount; i-- > 0;) {
+				limb_type shifted{ 0 };
+				if (i >= limbShift) {
+					shifted = m_limbs[i - limbShift] << bitShift;
+					if (bitShift != 0 && i > limbShift) shifted |= m_limbs[i - limbShift - 1] >> (64 - bitShift);
+				}
+				m_limbs[i] = shifted;
+			}
+			return *this;
+		}
+
+		constexpr FixedInt& operator>>=(std::size_t shift) {
+			const std::size_t limbShift{ shift / 64 };
+			const unsigned bitShift{ static_cast<unsigned>(shift % 64) };
+			for (std::size_t i = 0; i < limbCount; ++i) {
+				limb_type shifted{ 0 };
+				if (limbShift < limbCount - i) {
+					shifted = m_limbs[i + limbShift] >> bitShift;
+					if (bitShift != 0 && limbShift < limbCount - i - 1) shifted |= m_limbs[i + limbShift + 1] << (64 - bitShift);
+				}
+				m_limbs[i] = shifted;
+			}
+			return *this;
+		}
+
+		constexpr FixedInt& operator&=(const FixedInt& inInt) {
+			for (std::size_t i = 0; i < limbCount; ++i) m_limbs[i] &= inInt.m_limbs[i];
+			return *this;
+		}
+
+		constexpr FixedInt& operator|=(const FixedInt& inInt) {
+			for (std::size_t i = 0; i < limbCount; ++i) m_limbs[i] |= inInt.m_limbs[i];
+			return *this;
+		}
+
+		constexpr FixedInt& operator^=(const FixedInt& inInt) {
+			for (std::size_t i = 0; i < limbCount; ++i) m_limbs[i] ^= inInt.m_limbs[i];
+			return *this;
+		}
+
+		constexpr FixedInt operator~() const {
+			FixedInt solution{};
+			for (std::size_t i = 0; i < limbCount; ++i) solution.m_limbs[i] = ~m_limbs[i];
+			return solution;
+		}
+
+		friend constexpr FixedInt operator<<(FixedInt lhs, std::size_t shift) { return lhs <<= shift; }
+		friend constexpr FixedInt operator>>(FixedInt lhs, std::size_t shift) { return lhs >>= shift; }
+		friend constexpr FixedInt operator&(FixedInt lhs, const FixedInt& rhs) { return lhs &= rhs; }
+		friend constexpr FixedInt operator|(FixedInt lhs, const FixedInt& rhs) { return lhs |= rhs; }
+		friend constexpr FixedInt operator^(FixedInt lhs, const FixedInt& rhs) { return lhs ^= rhs; }
+
+		/*
+		* COMPARISON OPERATORS
+		*/
+		friend constexpr bool operator==(const FixedInt& lhs, const FixedInt& rhs) {
+			for (std::size_t i = 0; i < limbCount; ++i) {
+				if (lhs.m_limbs[i] != rhs.m_limbs[i]) return false;
+			}
+			return true;
+		}
+
+		friend constexpr bool operator<(const FixedInt& lhs, const FixedInt& rhs) {
+			for (std::size_t i = limbCount; i-- > 0;) {
+				if (lhs.m_limbs[i] != rhs.m_limbs[i]) return lhs.m_limbs[i] < rhs.m_limbs[i];
+			}
+			return false;
+		}
+
+		friend constexpr bool operator!=(const FixedInt& lhs, const FixedInt& rhs) { return !(lhs == rhs); }
+		friend constexpr bool operator>(const FixedInt& lhs, const FixedInt& rhs) { return rhs < lhs; }
+		friend constexpr bool operator<=(const FixedInt& lhs, const FixedInt& rhs) { return !(rhs < lhs); }
+		friend constexpr bool operator>=(const FixedInt& lhs, const FixedInt& rhs) { return !(lhs < rhs); }
+	};
+
+	using UInt256 = FixedInt<256>;
+	using UInt512 = FixedInt<512>;
+}
+
+#endif
@@ -0,0 +1,222 @@
+#ifndef LIMBBUFFER
+#define LIMBBUFFER
+
+/*
+* The storage behind a BigInt's limbs. This behaves as a cut-down std::vector<uint64_t>, except that the first few limbs live inside the object itself
+* and only spill over onto the heap once a value grows past them. As most numbers in practice fit within a couple of limbs, this means creating, copying
+* and destroying a typical BigInt never touches the allocator.
+* Larger buffers come from a std::pmr::memory_resource. As with the std::pmr containers, the resource is fixed when the buffer is constructed, moves
+* take it along with the limbs, copies use the default resource unless told otherwise, and assignment never changes it.
+* This is an implementation detail of BigInt, whose only use outside of it is to build up limbs to hand over to a BigInt (as BigInt::LimbBuffer) without copying.
+*/
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <memory_resource>
+#include <utility>
+
+//The number of limbs held inline before a BigInt allocates. Four limbs covers anything up to 256 bits.
+#ifndef DP_BIGINT_INLINE_LIMBS
+#define DP_BIGINT_INLINE_LIMBS 4
+#endif
+
+namespace dp {
+	namespace detail {
+
+		class LimbBuffer
+		{
+		public:
+			using value_type = std::uint64_t;
+			using size_type = std::size_t;
+			using iterator = value_type*;
+			using const_iterator = const value_type*;
+
+			static constexpr size_type inlineCapacity{ DP_BIGINT_INLINE_LIMBS };
+			static_assert(inlineCapacity >= 1, "DP_BIGINT_INLINE_LIMBS must be at least 1 limb");
+
+		private:
+			value_type*					m_data;			//Points to either m_inline or an allocation of m_capacity limbs from m_resource.
+			size_type					m_size;
+			size_type					m_capacity;
+			std::pmr::memory_resource*	m_resource;
+			value_type					m_inline[inlineCapacity];
+
+			bool isInline() const noexcept {
+				return m_data == m_inline;
+			}
+
+			void release() noexcept {
+				if (!isInline()) m_resource->deallocate(m_data, m_capacity * sizeof(value_type), alignof(value_type));
+				m_data = m_inline;
+				m_capacity = inlineCapacity;
+			}
+
+			//Moves the contents into a buffer of exactly newCapacity limbs, which must be able to hold them.
+			void reallocate(size_type newCapacity) {
+				value_type* newData{ static_cast<value_type*>(m_resource->allocate(newCapacity * sizeof(value_type), alignof(value_type))) };
+				std::copy(m_data, m_data + m_size, newData);
+				release();
+				m_data = newData;
+				m_capacity = newCapacity;
+			}
+
+			//Geometric growth, as std::vector does, so that a run of push_backs costs amortised constant time.
+			void grow(size_type minimumCapacity) {
+				reallocate(std::max(minimumCapacity, 2 * m_capacity));
+			}
+
+		public:
+			LimbBuffer() noexcept : LimbBuffer{ std::pmr::get_default_resource() } {}
+
+			explicit LimbBuffer(std::pmr::memory_resource* resource) noexcept : m_data{ m_inline }, m_size{ 0 }, m_capacity{ inlineCapacity }, m_resource{ resource } {}
+
+			LimbBuffer(const LimbBuffer& other) : LimbBuffer{} {
+				assign(other.begin(), other.end());
+			}
+
+			LimbBuffer(const LimbBuffer& other, std::pmr::memory_resource* resource) : LimbBuffer{ resource } {
+				assign(other.begin(), other.end());
+			}
+
+			//A heap buffer is stolen outright; inline limbs have to be copied across.
+			LimbBuffer(LimbBuffer&& other) noexcept : LimbBuffer{ other.m_resource } {
+				*this = std::move(other);
+			}
+
+			//If the resources differ the buffer can't be stolen, so this copies instead.
+			LimbBuffer(LimbBuffer&& other, std::pmr::memory_resource* resource) : LimbBuffer{ resource } {
+				*this = std::move(other);
+			}
+
+			LimbBuffer& operator=(const LimbBuffer& other) {
+				if (this != &other) assign(other.begin(), other.end());
+				return *this;
+			}
+
+			//Only noexcept in practice when both buffers share a resource, or when the limbs fit in what we already hold.
+			LimbBuffer& operator=(LimbBuffer&& other) {
+				if (this == &other) return *this;
+				if (other.isInline() || m_resource != other.m_resource) {
+					if (other.m_size > m_capacity) {
+						m_size = 0;
+						reallocate(other.m_size);
+					}
+					std::copy(other.m_data, other.m_data + other.m_size, m_data);
+					m_size = other.m_size;
+				}
+				else {
+					release();
+					m_data = other.m_data;
+					m_size = other.m_size;
+					m_capacity = other.m_capacity;
+					other.m_data = other.m_inline;
+					other.m_capacity = inlineCapacity;
+				}
+				other.m_size = 0;
+				return *this;
+			}
+
+			~LimbBuffer() {
+				release();
+			}
+
+			/*
+			* ACCESS
+			*/
+			value_type* data() noexcept { return m_data; }
+			const value_type* data() const noexcept { return m_data; }
+			value_type& operator[](size_type index) noexcept { return m_data[index]; }
+			const value_type& operator[](size_type index) const noexcept { return m_data[index]; }
+			value_type& back() noexcept { return m_data[m_size - 1]; }
+			const value_type& back() const noexcept { return m_data[m_size - 1]; }
+
+			iterator begin() noexcept { return m_data; }
+			const_iterator begin() const noexcept { return m_data; }
+			iterator end() noexcept { return m_data + m_size; }
+			const_iterator end() const noexcept { return m_data + m_size; }
+
+			size_type size() const noexcept { return m_size; }
+			size_type capacity() const noexcept { return m_capacity; }
+			std::pmr::memory_resource* resource() const noexcept { return m_resource; }
+			bool empty() const noexcept { return m_size == 0; }
+
+			/*
+			* MODIFIERS
+			*/
+			void reserve(size_type newCapacity) {
+				if (newCapacity > m_capacity) reallocate(newCapacity);
+			}
+
+			//New limbs are zeroed, as with std::vector.
+			void resize(size_type newSize) {
+				if (newSize > m_capacity) grow(newSize);
+				if (newSize > m_size) std::fill(m_data + m_size, m_data + newSize, value_type{ 0 });
+				m_size = newSize;
+			}
+
+			void assign(size_type count, value_type value) {
+				if (count > m_capacity) {
+					m_size = 0;
+					reallocate(count);
+				}
+				std::fill(m_data, m_data + count, value);
+				m_size = count;
+			}
+
+			void assign(const value_type* first, const value_type* last) {
+				const size_type count{ static_cast<size_type>(last - first) };
+				if (count > m_capacity) {
+					m_size = 0;
+					reallocate(count);
+				}
+				std::copy(first, last, m_data);
+				m_size = count;
+			}
+
+			void push_back(value_type value) {
+				if (m_size == m_capacity) grow(m_size + 1);
+				m_data[m_size++] = value;
+			}
+
+			void pop_back() noexcept {
+				--m_size;
+			}
+
+			void clear() noexcept {
+				m_size = 0;
+			}
+
+			//Gives back any heap storage beyond the current size, moving the limbs back inline if they now fit there.
+			void shrink_to_fit() {
+				if (isInline() || m_size == m_capacity) return;
+				if (m_size > inlineCapacity) {
+					reallocate(m_size);
+					return;
+				}
+				value_type* heapData{ m_data };
+				const size_type heapCapacity{ m_capacity };
+				std::copy(heapData, heapData + m_size, m_inline);
+				m_resource->deallocate(heapData, heapCapacity * sizeof(value_type), alignof(value_type));
+				m_data = m_inline;
+				m_capacity = inlineCapacity;
+			}
+
+			//Each buffer keeps its own resource, so limbs are only exchanged by pointer when both are on the heap of the same resource.
+			void swap(LimbBuffer& other) {
+				if (!isInline() && !other.isInline() && m_resource == other.m_resource) {
+					std::swap(m_data, other.m_data);
+					std::swap(m_size, other.m_size);
+					std::swap(m_capacity, other.m_capacity);
+					return;
+				}
+				LimbBuffer temporary{ std::move(other) };
+				other = std::move(*this);
+				*this = std::move(temporary);
+			}
+		};
+
+	}
+}
+
+#endif
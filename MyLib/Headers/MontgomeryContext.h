@@ -0,0 +1,59 @@
+#ifndef MONTGOMERYCONTEXT
+#define MONTGOMERYCONTEXT
+
+/*
+* Modular arithmetic against a fixed odd modulus by Montgomery's method. The context precomputes R^2 mod n and n' = -n^-1 mod 2^64 for R = 2^(64k), with
+* k the number of limbs in the modulus, after which every reduction is a handful of multiply-adds rather than a long division.
+* The working limb buffers are allocated once and reused by each call, so a context should not be shared between threads without synchronisation.
+*/
+
+#include <cstdint>
+#include <vector>
+
+#include "BigInt.h"
+
+namespace dp {
+
+	class MontgomeryContext
+	{
+		using limb_type = BigInt::arrayType;
+
+		BigInt					m_modulus;
+		std::size_t				m_size;			//The number of limbs in the modulus, and in every value held in Montgomery form.
+		limb_type				m_inverse;		//-n^-1 mod 2^64
+		std::vector<limb_type>	m_rSquared;		//R^2 mod n, which takes a value into Montgomery form.
+		std::vector<limb_type>	m_one;			//1 in Montgomery form, i.e. R mod n.
+
+		//Working buffers: a double-width product awaiting reduction, and space for the operands in Montgomery form.
+		std::vector<limb_type>	m_product;
+		std::vector<limb_type>	m_left;
+		std::vector<limb_type>	m_right;
+		std::vector<limb_type>	m_powers;		//The odd powers of the base used by powmod's sliding window, m_size limbs apiece.
+
+		//out = a * b * R^-1 mod n. out may alias a or b.
+		void multiply(limb_type* out, const limb_type* a, const limb_type* b);
+		//out = a * a * R^-1 mod n, by the squaring kernel. out may alias a.
+		void square(limb_type* out, const limb_type* a);
+
+		//Writes value mod n into out as m_size limbs. Values already in [0, n) are copied straight in; anything else has to take the general division.
+		void load(const BigInt& value, std::vector<limb_type>& out) const;
+
+		BigInt toBigInt(const std::vector<limb_type>& limbs) const;
+
+	public:
+		//The modulus must be odd and positive; anything else throws std::invalid_argument.
+		explicit MontgomeryContext(const BigInt& modulus);
+
+		const BigInt& modulus() const;
+
+		//Each of these takes and returns ordinary values, converting in and out of Montgomery form internally. Operands outside [0, n) are reduced
+		//first, but the results are always in [0, n).
+		BigInt mulmod(const BigInt& a, const BigInt& b);
+		BigInt sqrmod(const BigInt& a);
+		//base^exponent mod n. A negative exponent throws std::invalid_argument.
+		BigInt powmod(const BigInt& base, const BigInt& exponent);
+	};
+
+}
+
+#endif
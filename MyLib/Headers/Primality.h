@@ -0,0 +1,28 @@
+#ifndef PRIMALITY
+#define PRIMALITY
+
+/*
+* Probable-prime tests and prime generation for BigInts. Every test starts with trial division by the odd primes below 1024, which needs only
+* single-limb remainders and settles most composites, and anything below 1024^2 outright. Only what survives goes on to modular exponentiation,
+* which runs through a MontgomeryContext for the number being tested.
+*/
+
+#include "BigInt.h"
+
+namespace dp {
+
+	//The Miller-Rabin test to rounds bases, the first of which is 2 and the rest chosen at random. A composite passes each round with probability
+	//at most 1/4. Values below 2 are not prime.
+	bool millerRabin(const BigInt& n, unsigned rounds = 25);
+
+	//The Baillie-PSW test: a strong probable-prime test to base 2, followed by a strong Lucas test with Selfridge's parameters. This is deterministic,
+	//is exact below 2^64, and no composite is known to pass it. Values below 2 are not prime.
+	bool bailliePSW(const BigInt& n);
+
+	//The smallest probable prime (by Baillie-PSW) greater than n. Candidates are sieved against the small primes by updating their residues as
+	//we step through them, so only the few which survive are tested in full.
+	BigInt nextPrime(const BigInt& n);
+
+}
+
+#endif
@@ -1,4 +1,367 @@
 #include "BigInt.h"
+#include "BigIntKernels.h"
+#include "MontgomeryContext.h"
+#include "BigIntExpr.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+//Helpers for radix conversion, which work directly on limb arrays. These are internal to the workings of the class.
+namespace {
+
+	using dp::detail::limb_type;
+
+	//10^19 is the largest power of 10 which fits in a limb, so we convert to and from decimal 19 digits at a time.
+	//It happens to have its top bit set already, so needs no normalising for divRemPreinverted.
+	constexpr limb_type decimalChunk{ 10000000000000000000ULL };
+	constexpr std::size_t digitsPerChunk{ 19 };
+
+	//Below this many limbs, decimal conversion peels off one chunk at a time rather than splitting the number in half.
+	constexpr std::size_t decimalSplitThreshold{ 48 };
+
+	//10^(19 * 2^k) along with its reciprocal for Barrett division, and the number of decimal digits in a number below it.
+	struct DecimalPower {
+		std::vector<limb_type> value;
+		std::vector<limb_type> reciprocal;
+		std::size_t digits;
+	};
+
+	void trimLimbs(std::vector<limb_type>& x) {
+		while (!x.empty() && x.back() == 0) x.pop_back();
+	}
+
+	//The powers 10^19, 10^38, 10^76, ... up to the first whose square must exceed a number of limbCount limbs.
+	//The reciprocals are only needed for dividing by the powers, so can be skipped when we only multiply by them.
+	std::vector<DecimalPower> decimalPowers(std::size_t limbCount, bool withReciprocals = true) {
+		std::vector<DecimalPower> powers;
+		powers.push_back(DecimalPower{ { decimalChunk }, {}, digitsPerChunk });
+		while (2 * powers.back().value.size() - 1 <= limbCount) {
+			const auto& previous{ powers.back().value };
+			std::vector<limb_type> squared(2 * previous.size());
+			dp::detail::mul(squared.data(), previous.data(), previous.size(), previous.data(), previous.size());
+			trimLimbs(squared);
+			powers.push_back(DecimalPower{ std::move(squared), {}, 2 * powers.back().digits });
+		}
+		//Reciprocals are only needed for the powers large enough to split on.
+		if (!withReciprocals) return powers;
+		for (auto& power : powers) {
+			if (power.value.size() >= decimalSplitThreshold / 2) power.reciprocal = dp::detail::reciprocal(power.value.data(), power.value.size());
+		}
+		return powers;
+	}
+
+	//An upper bound on the number of decimal digits in a number of limbCount limbs. 1234/4096 is just above log10(2).
+	std::size_t decimalLengthBound(std::size_t limbCount) {
+		return limbCount * 64 * 1234 / 4096 + 2;
+	}
+
+	//Splits x < power^2 into {x / power, x % power}.
+	std::pair<std::vector<limb_type>, std::vector<limb_type>> splitByPower(const std::vector<limb_type>& x, const DecimalPower& power) {
+		const std::size_t powerSize{ power.value.size() };
+		if (x.size() < powerSize) return { {}, x };
+		std::vector<limb_type> quotient(x.size() - powerSize + 1);
+		std::vector<limb_type> remainder(powerSize);
+		if (power.reciprocal.empty()) dp::detail::divRem(quotient.data(), remainder.data(), x.data(), x.size(), power.value.data(), powerSize);
+		else dp::detail::divRemBarrett(quotient.data(), remainder.data(), x.data(), x.size(), power.value.data(), powerSize, power.reciprocal);
+		trimLimbs(quotient);
+		trimLimbs(remainder);
+		return { std::move(quotient), std::move(remainder) };
+	}
+
+	//Writes the 19 digits of a chunk so that they end just before end, returning the first digit written. If padded is false, leading zeroes are not written.
+	char* writeChunk(limb_type chunk, char* end, bool padded) {
+		for (std::size_t i = 0; i < digitsPerChunk && (padded || chunk != 0); ++i) {
+			*--end = static_cast<char>('0' + chunk % 10);
+			chunk /= 10;
+		}
+		return end;
+	}
+
+	//Writes the digits of x so that they end just before end, by repeated single-limb division. If width is non-zero exactly that many digits are
+	//written, padded with leading zeroes. Otherwise only the significant digits are written. Returns the first digit written.
+	char* writeDecimalBasecase(std::vector<limb_type> x, char* end, std::size_t width) {
+		static const limb_type chunkReciprocal{ dp::detail::reciprocalOf(decimalChunk) };
+		char* position{ end };
+		while (!x.empty()) {
+			limb_type chunk{ dp::detail::divRemPreinverted(x.data(), x.data(), x.size(), decimalChunk, chunkReciprocal, 0) };
+			trimLimbs(x);
+			position = writeChunk(chunk, position, !x.empty());
+		}
+		if (width != 0) {
+			char* start{ end - width };
+			std::fill(start, position, '0');
+			return start;
+		}
+		return position;
+	}
+
+	//Writes exactly powers[level].digits digits of x < 10^powers[level].digits, ending just before end, by splitting x in two around the next power down.
+	char* writeDecimalPadded(const std::vector<limb_type>& x, char* end, const std::vector<DecimalPower>& powers, std::size_t level) {
+		const std::size_t width{ powers[level].digits };
+		if (level == 0 || x.size() < decimalSplitThreshold) return writeDecimalBasecase(x, end, width);
+		auto [high, low] { splitByPower(x, powers[level - 1]) };
+		writeDecimalPadded(low, end, powers, level - 1);
+		writeDecimalPadded(high, end - powers[level - 1].digits, powers, level - 1);
+		return end - width;
+	}
+
+	//Writes the significant digits of a non-zero x ending just before end. The low half is split off by the largest power not exceeding x,
+	//so the top half carries no leading zeroes.
+	char* writeDecimal(const std::vector<limb_type>& x, char* end, const std::vector<DecimalPower>& powers) {
+		if (x.size() < decimalSplitThreshold) return writeDecimalBasecase(x, end, 0);
+		std::size_t level{ powers.size() - 1 };
+		while (dp::detail::compare(powers[level].value.data(), powers[level].value.size(), x.data(), x.size()) > 0) --level;
+		auto [high, low] { splitByPower(x, powers[level]) };
+		writeDecimalPadded(low, end, powers, level);
+		return writeDecimal(high, end - powers[level].digits, powers);
+	}
+
+	//The value of a run of decimal digits, which must all be valid, by multiply-and-add of up to 19 digits at a time.
+	std::vector<limb_type> parseDecimalBasecase(std::string_view digits) {
+		static constexpr limb_type powersOfTen[digitsPerChunk + 1]{ 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+			10000000000, 100000000000, 1000000000000, 10000000000000, 100000000000000, 1000000000000000, 10000000000000000, 100000000000000000,
+			1000000000000000000, decimalChunk };
+		std::vector<limb_type> result{};
+		result.reserve(digits.size() / digitsPerChunk + 1);
+		//The first chunk takes whatever is left over so that every subsequent chunk is a full 19 digits.
+		std::size_t chunkLength{ digits.size() % digitsPerChunk };
+		if (chunkLength == 0) chunkLength = digitsPerChunk;
+		for (std::size_t position = 0; position < digits.size(); position += chunkLength, chunkLength = digitsPerChunk) {
+			limb_type chunk{ 0 };
+			for (std::size_t i = position; i < position + chunkLength; ++i) {
+				chunk = chunk * 10 + static_cast<limb_type>(digits[i] - '0');
+			}
+			limb_type carry{ dp::detail::mulSingle(result.data(), result.data(), result.size(), powersOfTen[chunkLength]) };
+			carry += dp::detail::addSingle(result.data(), result.data(), result.size(), chunk);
+			if (carry != 0) result.push_back(carry);
+		}
+		return result;
+	}
+
+	//The value of a run of decimal digits. Long runs are split so that the low part is a power's worth of digits, and recombined as high * power + low.
+	std::vector<limb_type> parseDecimal(std::string_view digits, const std::vector<DecimalPower>& powers) {
+		if (digits.size() < decimalSplitThreshold * digitsPerChunk) return parseDecimalBasecase(digits);
+		std::size_t level{ powers.size() - 1 };
+		while (powers[level].digits >= digits.size()) --level;
+		const auto& power{ powers[level] };
+
+		std::vector<limb_type> high{ parseDecimal(digits.substr(0, digits.size() - power.digits), powers) };
+		std::vector<limb_type> low{ parseDecimal(digits.substr(digits.size() - power.digits), powers) };
+		if (high.empty()) return low;
+
+		std::vector<limb_type> result(high.size() + power.value.size());
+		dp::detail::mul(result.data(), high.data(), high.size(), power.value.data(), power.value.size());
+		if (!low.empty()) dp::detail::addUnequal(result.data(), result.data(), result.size(), low.data(), low.size());
+		trimLimbs(result);
+		return result;
+	}
+
+	//The value of a run of digits in a power of two base, which must all be valid. Each digit is a fixed group of bits, so this is a matter of packing them.
+	std::vector<limb_type> parsePowerOfTwo(std::string_view digits, unsigned bitsPerDigit) {
+		std::vector<limb_type> result((digits.size() * bitsPerDigit + 63) / 64, 0);
+		std::size_t bitIndex{ 0 };
+		for (std::size_t i = digits.size(); i-- > 0; bitIndex += bitsPerDigit) {
+			const char digit{ digits[i] };
+			limb_type value{ static_cast<limb_type>((digit <= '9') ? digit - '0' : (digit | 0x20) - 'a' + 10) };
+			result[bitIndex / 64] |= value << (bitIndex % 64);
+		}
+		trimLimbs(result);
+		return result;
+	}
+
+	bool isDigit(char digit, int base) {
+		switch (base) {
+		case 2:
+			return digit == '0' || digit == '1';
+		case 16:
+			return (digit >= '0' && digit <= '9') || ((digit | 0x20) >= 'a' && (digit | 0x20) <= 'f');
+		default:
+			return digit >= '0' && digit <= '9';
+		}
+	}
+
+	//Scratch space for in-place multiplication, swapped with the destination's limbs after each product.
+	//The buffer lives as long as its thread, so it allocates from new and delete rather than whatever the default resource was when it was first used,
+	//which could be an arena that has since gone. Swapping only exchanges pointers between buffers on the same resource, so scratch memory is never
+	//handed to the caller's resource, nor the caller's memory kept here.
+	dp::detail::LimbBuffer& productScratch() {
+		thread_local dp::detail::LimbBuffer scratch{ std::pmr::new_delete_resource() };
+		return scratch;
+	}
+
+	//The most limbs the scratch buffer keeps hold of between products. A product bigger than this takes so long that allocating afresh for the next one
+	//costs nothing beside it, so rather than have every thread which ever did one hold its memory until it exits, the buffer is given back.
+	constexpr std::size_t productScratchLimit{ dp::detail::parallelThreshold };
+
+	void releaseLargeScratch(dp::detail::LimbBuffer& scratch) {
+		if (scratch.capacity() <= productScratchLimit) return;
+		scratch.clear();
+		scratch.shrink_to_fit();
+	}
+
+	//A term of a deferred sum, resolved to a run of limbs to add or subtract. Plain terms point at their BigInt, and products are found at an offset
+	//into the product scratch buffer.
+	struct SumOperand {
+		const dp::BigInt* value;
+		const limb_type* limbs;
+		std::size_t offset;
+		std::size_t size;
+		bool negative;
+	};
+
+	std::vector<SumOperand>& sumOperands() {
+		thread_local std::vector<SumOperand> operands;
+		return operands;
+	}
+}
+
+//Helpers for taking integer roots.
+namespace {
+
+	//Bit r is set when r is a square modulo the given modulus, which must be no more than 64.
+	constexpr std::uint64_t squareResidues(unsigned modulus) {
+		std::uint64_t residues{ 0 };
+		for (unsigned i = 0; i < modulus; ++i) residues |= static_cast<std::uint64_t>(1) << (i * i % modulus);
+		return residues;
+	}
+
+	//floor(x^(1/n)) for x > 0 of exactly bits bits, and 2 <= n < bits. Newton's iteration s' = ((n-1)s + x / s^(n-1)) / n only converges quadratically
+	//once it is close, so rather than run it at full precision from a rough start, we take the root of the leading half of the root's bits first
+	//and let a single step at full size double them. At the bottom of the recursion the seed comes from a floating-point root of the leading limb.
+	dp::BigInt rootMagnitude(const dp::BigInt& x, std::size_t bits, std::uint64_t n) {
+		const std::size_t rootBits{ static_cast<std::size_t>((bits + n - 1) / n) };
+		dp::BigInt root;
+		if (rootBits <= 62) {
+			const std::size_t discarded{ bits > 64 ? bits - 64 : 0 };
+			const double leading{ static_cast<double>(static_cast<limb_type>(x >> discarded)) };
+			const double estimate{ std::exp2((std::log2(leading) + static_cast<double>(discarded)) / static_cast<double>(n)) };
+			root = dp::BigInt{ static_cast<limb_type>(estimate) + 1 };
+		}
+		else {
+			const std::size_t shift{ rootBits / 2 - 2 };
+			root = rootMagnitude(x >> (n * shift), bits - n * shift, n).xLS(shift);
+		}
+
+		//One step from anywhere lands on or above the root, after which each step moves down towards it until s^n <= x.
+		const dp::BigInt weight{ n - 1 };
+		dp::BigInt power{ pow(root, n - 1) };
+		root = (weight * root + x / power) / n;
+		while (true) {
+			power = pow(root, n - 1);
+			if (power * root <= x) return root;
+			root = (weight * root + x / power) / n;
+		}
+	}
+}
+
+//Helpers for converting between limbs and bytes. Each limb is put together a byte at a time, which doesn't depend on the host's byte order.
+namespace {
+
+	using dp::detail::limb_type;
+	using dp::ByteOrder;
+
+	constexpr std::size_t bytesPerLimb{ sizeof(limb_type) };
+	static_assert(bytesPerLimb == 8, "The whole-limb byte conversions assume 64-bit limbs");
+
+	//Where byte i of a limb, counting from the least significant, goes among its bytes in the given order.
+	template<ByteOrder Order>
+	constexpr std::size_t bytePosition(std::size_t i, std::size_t count = bytesPerLimb) {
+		return Order == ByteOrder::little ? i : count - 1 - i;
+	}
+
+	//The whole-limb conversions are written out in full, as compilers only recognise them as a single load or store (byte-swapped if need be)
+	//when the loop is already unrolled.
+	template<ByteOrder Order>
+	void storeLimb(limb_type limb, std::uint8_t* out) {
+		out[bytePosition<Order>(0)] = static_cast<std::uint8_t>(limb);
+		out[bytePosition<Order>(1)] = static_cast<std::uint8_t>(limb >> 8);
+		out[bytePosition<Order>(2)] = static_cast<std::uint8_t>(limb >> 16);
+		out[bytePosition<Order>(3)] = static_cast<std::uint8_t>(limb >> 24);
+		out[bytePosition<Order>(4)] = static_cast<std::uint8_t>(limb >> 32);
+		out[bytePosition<Order>(5)] = static_cast<std::uint8_t>(limb >> 40);
+		out[bytePosition<Order>(6)] = static_cast<std::uint8_t>(limb >> 48);
+		out[bytePosition<Order>(7)] = static_cast<std::uint8_t>(limb >> 56);
+	}
+
+	template<ByteOrder Order>
+	limb_type loadLimb(const std::uint8_t* in) {
+		return static_cast<limb_type>(in[bytePosition<Order>(0)])
+			| static_cast<limb_type>(in[bytePosition<Order>(1)]) << 8
+			| static_cast<limb_type>(in[bytePosition<Order>(2)]) << 16
+			| static_cast<limb_type>(in[bytePosition<Order>(3)]) << 24
+			| static_cast<limb_type>(in[bytePosition<Order>(4)]) << 32
+			| static_cast<limb_type>(in[bytePosition<Order>(5)]) << 40
+			| static_cast<limb_type>(in[bytePosition<Order>(6)]) << 48
+			| static_cast<limb_type>(in[bytePosition<Order>(7)]) << 56;
+	}
+
+	//The low count bytes of a partial top limb.
+	template<ByteOrder Order>
+	void storePartialLimb(limb_type limb, std::uint8_t* out, std::size_t count) {
+		for (std::size_t i = 0; i < count; ++i) out[bytePosition<Order>(i, count)] = static_cast<std::uint8_t>(limb >> (8 * i));
+	}
+
+	template<ByteOrder Order>
+	limb_type loadPartialLimb(const std::uint8_t* in, std::size_t count) {
+		limb_type limb{ 0 };
+		for (std::size_t i = 0; i < count; ++i) limb |= static_cast<limb_type>(in[bytePosition<Order>(i, count)]) << (8 * i);
+		return limb;
+	}
+
+	//Writes the low byteCount bytes of the limbs to out. In big-endian order the least significant limb goes at the end, and a partial top limb at the start.
+	template<ByteOrder Order>
+	void storeBytes(const limb_type* limbs, std::size_t byteCount, std::uint8_t* out) {
+		const std::size_t whole{ byteCount / bytesPerLimb };
+		const std::size_t rest{ byteCount % bytesPerLimb };
+		for (std::size_t i = 0; i < whole; ++i) {
+			storeLimb<Order>(limbs[i], out + (Order == ByteOrder::little ? i * bytesPerLimb : byteCount - (i + 1) * bytesPerLimb));
+		}
+		if (rest != 0) storePartialLimb<Order>(limbs[whole], out + (Order == ByteOrder::little ? whole * bytesPerLimb : 0), rest);
+	}
+
+	//Replaces the contents of limbs with the number held in byteCount bytes, which may leave leading zero limbs.
+	template<ByteOrder Order>
+	void loadBytes(const std::uint8_t* in, std::size_t byteCount, dp::detail::LimbBuffer& limbs) {
+		const std::size_t whole{ byteCount / bytesPerLimb };
+		const std::size_t rest{ byteCount % bytesPerLimb };
+		limbs.clear();
+		limbs.resize(whole + (rest != 0 ? 1 : 0));
+		for (std::size_t i = 0; i < whole; ++i) {
+			limbs[i] = loadLimb<Order>(in + (Order == ByteOrder::little ? i * bytesPerLimb : byteCount - (i + 1) * bytesPerLimb));
+		}
+		if (rest != 0) limbs[whole] = loadPartialLimb<Order>(in + (Order == ByteOrder::little ? whole * bytesPerLimb : 0), rest);
+	}
+
+	std::size_t varintSize(std::size_t value) {
+		std::size_t size{ 1 };
+		for (; value >= 0x80; value >>= 7) ++size;
+		return size;
+	}
+
+	std::uint8_t* writeVarint(std::size_t value, std::uint8_t* out) {
+		for (; value >= 0x80; value >>= 7) *out++ = static_cast<std::uint8_t>(value | 0x80);
+		*out++ = static_cast<std::uint8_t>(value);
+		return out;
+	}
+
+	//Returns nullptr if the varint runs past last, or holds more than a std::size_t can.
+	const std::uint8_t* readVarint(const std::uint8_t* first, const std::uint8_t* last, std::size_t& value) {
+		constexpr unsigned digits{ std::numeric_limits<std::size_t>::digits };
+		std::size_t result{ 0 };
+		for (unsigned shift = 0; first != last && shift < digits; shift += 7) {
+			const std::size_t chunk{ *first & 0x7fu };
+			if (shift + 7 > digits && (chunk >> (digits - shift)) != 0) return nullptr;
+			result |= chunk << shift;
+			if ((*first++ & 0x80) == 0) {
+				value = result;
+				return first;
+			}
+		}
+		return nullptr;
+	}
+}
 
 namespace dp {
 
@@ -8,16 +371,13 @@ namespace dp {
 
 
 	void BigInt::trimLeadingZeroes() {
-		//To prevent a for loop which could execute indefinitely considering size_t is unsigned, we count up and use arithmetic to simulate counting down.
-		const auto maxSize{ m_bits.size() };
-		for (std::size_t i = 0; i < maxSize; ++i) {
-			if (m_bits[maxSize - i - 1] == 0) m_bits.pop_back();//This should be a safe operation as popping m_bits[i] doesn't change the value returned by m_bits[i-1]
-			else break;										//Break after the first non-zero element as we only want to trim leading zeroes.
-		}
+		//Most results have no leading zero limbs at all. Where they do, such as after subtracting two close values, the leading zero bits are counted
+		//a vector at a time and every whole zero limb dropped at once.
+		if (!m_bits.empty() && m_bits.back() != 0) return;
+		m_bits.resize(m_bits.size() - detail::countLeadingZeros(m_bits.data(), m_bits.size()) / unitSize);
 		if (m_bits.size() == 0)m_bits.push_back(0);			//In the case where this function is called on a BigInt with value zero, we don't want to leave the BigInt empty.
 	}
 
-
 	void BigInt::matchVectorSize(const BigInt& toMatch) {
 		m_bits.reserve(toMatch.m_bits.size());
 		for (auto i = m_bits.size(); i < toMatch.m_bits.size(); ++i) {
@@ -58,87 +418,225 @@ namespace dp {
 		setNthBit(m_bits[term], remainder, inBit);
 	}
 
-	//Our division function, using a somewhat optimised long division method.
-	//We pass the solution in by non-const reference from our operator/ and operator% so that we don't need to make an unnecessary copy between functions.
-	void BigInt::divide(const BigInt& dividend, const BigInt& divisor, BigInt& solution, bool returnRemainder) const {
-		//We make the choice to let dividing by 0 be UB rather than be the only function in the class to throw an exception.
-		//In this case, solution will have been default-initialised to 0
-		if (divisor == 0) {
+	void BigInt::addInPlace(const BigInt& rhs, bool negateRhs) {
+		//Sizes are taken up front and data pointers only after any resize, as rhs may be this BigInt.
+		const bool rhsSign{ rhs.m_sign != negateRhs };
+		const std::size_t thisSize{ m_bits.size() };
+		const std::size_t rhsSize{ rhs.m_bits.size() };
+
+		//Same signs: the magnitudes add and the sign is unchanged. The result is at most one limb longer than the longer operand.
+		if (m_sign == rhsSign) {
+			if (thisSize >= rhsSize) {
+				m_bits.push_back(0);
+				m_bits[thisSize] = detail::addUnequal(m_bits.data(), m_bits.data(), thisSize, rhs.m_bits.data(), rhsSize);
+			}
+			else {
+				m_bits.resize(rhsSize + 1);
+				m_bits[rhsSize] = detail::addUnequal(m_bits.data(), rhs.m_bits.data(), rhsSize, m_bits.data(), thisSize);
+			}
+			trimLeadingZeroes();
 			return;
 		}
-		if (divisor == 1) {
-			solution = dividend;
+
+		//Different signs: subtract the smaller magnitude from the larger and take the sign of the larger.
+		const int order{ detail::compare(m_bits.data(), thisSize, rhs.m_bits.data(), rhsSize) };
+		if (order == 0) {
+			m_bits.assign(1, 0);
+			m_sign = true;
 			return;
 		}
-		//Integer division => All cases of A/B for A < B -> 0.
-		if (dividend < divisor) {
-			if (returnRemainder) solution = dividend;
-			return;
+		if (order > 0) {
+			detail::subUnequal(m_bits.data(), m_bits.data(), thisSize, rhs.m_bits.data(), rhsSize);
+		}
+		else {
+			m_bits.resize(rhsSize);
+			detail::subUnequal(m_bits.data(), rhs.m_bits.data(), rhsSize, m_bits.data(), thisSize);
+			m_sign = rhsSign;
 		}
+		trimLeadingZeroes();
+	}
 
-		BigInt quotient;
-		BigInt remainder;
-		quotient.matchVectorSize(dividend);
-		remainder.matchVectorSize(divisor);
-		auto totalBits{ unitSize * dividend.m_bits.size() };
-		for (auto i = 0; i < totalBits; ++i) {			//Can't count down to 0 as i will likely be an unsigned type
+	void BigInt::assignSum(const detail::SumTerm* terms, std::size_t count) {
+		//Products are formed before m_bits is touched, as this BigInt may be one of their operands, and the limbs of plain terms are only looked up
+		//after m_bits is resized, as it may be one of those too.
+		auto& operands{ sumOperands() };
+		operands.clear();
+		detail::LimbBuffer& scratch{ productScratch() };
+		std::size_t scratchSize{ 0 };
+		std::size_t size{ 0 };
+		for (std::size_t i = 0; i < count; ++i) {
+			const auto& term{ terms[i] };
+			if (term.right) {
+				const std::size_t productSize{ term.left->m_bits.size() + term.right->m_bits.size() };
+				operands.push_back(SumOperand{ nullptr, nullptr, scratchSize, productSize, term.negative != (term.left->m_sign != term.right->m_sign) });
+				scratchSize += productSize;
+			}
+			else {
+				operands.push_back(SumOperand{ term.left, nullptr, 0, term.left->m_bits.size(), term.negative == term.left->m_sign });
+			}
+			size = std::max(size, operands.back().size);
+		}
+		scratch.resize(scratchSize);
+		for (std::size_t i = 0; i < count; ++i) {
+			const auto& term{ terms[i] };
+			if (term.right) detail::mul(scratch.data() + operands[i].offset, term.left->m_bits.data(), term.left->m_bits.size(), term.right->m_bits.data(), term.right->m_bits.size());
+		}
+		m_bits.resize(size);
+		for (auto& operand : operands) {
+			operand.limbs = operand.value ? operand.value->m_bits.data() : scratch.data() + operand.offset;
+		}
 
-			remainder = remainder.xLS(1);				//We specifically want the expanding left shift in this case.
-			//remainder <<= 1;
-			remainder.setTotalNthBit(0, dividend.getTotalNthBit(totalBits - i - 1));
-			if (remainder >= divisor) {
-				remainder -= divisor;
-				quotient.setTotalNthBit(totalBits - i - 1, true);
+		//Each limb of the result takes every term at once. The running carry is signed, and never grows past the number of terms, so it can be kept
+		//in a single word alongside the limb being formed. Every term is read at a position before the result is written there, so terms may alias it.
+		limb_type* out{ m_bits.data() };
+		std::int64_t carry{ 0 };
+		for (std::size_t i = 0; i < size; ++i) {
+			limb_type sum{ static_cast<limb_type>(carry) };
+			std::int64_t nextCarry{ carry < 0 ? -1 : 0 };
+			for (const auto& operand : operands) {
+				if (i >= operand.size) continue;
+				if (operand.negative) nextCarry -= detail::subBorrow(0, sum, operand.limbs[i], sum);
+				else nextCarry += detail::addCarry(0, sum, operand.limbs[i], sum);
 			}
+			out[i] = sum;
+			carry = nextCarry;
 		}
-		if (returnRemainder) {
-			remainder.trimLeadingZeroes();
-			solution = std::move(remainder);
+
+		if (carry >= 0) {
+			if (carry > 0) m_bits.push_back(static_cast<limb_type>(carry));
+			m_sign = true;
 		}
 		else {
-			quotient.trimLeadingZeroes();
-			solution = std::move(quotient);
+			//A negative sum is left in two's complement, borrowing from carry's worth of 2^(64 * size). Negating it gives back the magnitude.
+			for (std::size_t i = 0; i < size; ++i) out[i] = ~out[i];
+			const limb_type high{ static_cast<limb_type>(-(carry + 1)) + detail::addSingle(out, out, size, 1) };
+			if (high != 0) m_bits.push_back(high);
+			m_sign = false;
 		}
-		return;
-
+		trimLeadingZeroes();
+		releaseLargeScratch(scratch);
 	}
 
-	std::string BigInt::getBinaryString() const {
-		std::string output{};
-		for (auto j = 0; j < m_bits.size(); ++j) {
-			for (auto i = 0; i < unitSize; ++i) {
-				if (getNthBit(m_bits[m_bits.size() - j - 1], unitSize - 1 - i)) {
-					output += "1";
-				}
-				else output += "0";
-			}
-			output += ' ';
+	//Our division function, using word-level long division (Knuth's Algorithm D) on the magnitudes. The signs are resolved by operator/ and operator%.
+	//We pass the solution in by non-const reference from our operator/ and operator% so that we don't need to make an unnecessary copy between functions.
+	void BigInt::divide(const BigInt& dividend, const BigInt& divisor, BigInt& solution, bool returnRemainder) const {
+		//Dividing by 0 is left as UB, as it is for the built-in types, so that the arithmetic operators never throw. In practice solution will have
+		//been default-initialised to 0. Functions which take a modulus as an argument, such as powmod and modInverse, throw for 0 instead.
+		if (divisor == 0) {
+			return;
+		}
+		const auto& dividendBits{ dividend.m_bits };
+		const auto& divisorBits{ divisor.m_bits };
+		//Integer division => All cases of |A|/|B| for |A| < |B| -> 0.
+		if (detail::compare(dividendBits.data(), dividendBits.size(), divisorBits.data(), divisorBits.size()) < 0) {
+			if (returnRemainder) solution.m_bits = dividendBits;
+			return;
 		}
-		return output;
 
+		if (returnRemainder) {
+			solution.m_bits.resize(divisorBits.size());
+			detail::divRem(nullptr, solution.m_bits.data(), dividendBits.data(), dividendBits.size(), divisorBits.data(), divisorBits.size());
+		}
+		else {
+			solution.m_bits.resize(dividendBits.size() - divisorBits.size() + 1);
+			detail::divRem(solution.m_bits.data(), nullptr, dividendBits.data(), dividendBits.size(), divisorBits.data(), divisorBits.size());
+		}
+		solution.trimLeadingZeroes();
 	}
 
-	//I know this is horribly inefficient. It will be optimised later.
-	std::string BigInt::getDecimalString() const {
-		if (*this == 0) return std::string{ "0" };
+	BigInt::arrayType BigInt::divideMagnitude(arrayType divisor) {
+		arrayType remainder{ detail::divRemSingle(m_bits.data(), m_bits.data(), m_bits.size(), divisor) };
+		trimLeadingZeroes();
+		return remainder;
+	}
 
-		std::string output{};
-		BigInt buffer{ *this };
-		buffer.m_sign = true;
-		char digit;
-		while (buffer > 0) {
-			digit = '0' + static_cast<char>(static_cast<arrayType>(buffer % 10));
-			output += digit;
+	BigInt::arrayType BigInt::divideMagnitude(const InvariantDivisor& divisor) {
+		arrayType remainder{ detail::divRemPreinverted(m_bits.data(), m_bits.data(), m_bits.size(), divisor.m_normalised, divisor.m_reciprocal, divisor.m_shift) };
+		trimLeadingZeroes();
+		return remainder;
+	}
 
-			buffer /= 10;
+	void BigInt::assignNative(const detail::NativeInteger& value) {
+		m_bits.assign(1, value.low);
+		if (value.high != 0) m_bits.push_back(value.high);
+		m_sign = !value.negative;
+	}
 
+	void BigInt::addNative(const detail::NativeInteger& value, bool negate) {
+		if (value.high != 0) {
+			BigInt other;
+			other.assignNative(value);
+			addInPlace(other, negate);
+			return;
 		}
-		if (!m_sign) output += '-';
-		std::reverse(output.begin(), output.end());
-		return output;
+		if (value.low == 0) return;
 
+		//Same signs: the magnitudes add, and the carry can run at most one limb past the end.
+		if (m_sign != (value.negative != negate)) {
+			const arrayType carry{ detail::addSingle(m_bits.data(), m_bits.data(), m_bits.size(), value.low) };
+			if (carry != 0) m_bits.push_back(carry);
+			return;
+		}
+		//Differing signs: the smaller magnitude comes off the larger, which is only ever the single limb when this number is a single limb too.
+		if (m_bits.size() == 1 && m_bits[0] < value.low) {
+			m_bits[0] = value.low - m_bits[0];
+			m_sign = !m_sign;
+			return;
+		}
+		detail::subSingle(m_bits.data(), m_bits.data(), m_bits.size(), value.low);
+		trimLeadingZeroes();
+		if (*this == 0) m_sign = true;
 	}
 
+	void BigInt::multiplyNative(const detail::NativeInteger& value) {
+		if (value.high != 0) {
+			BigInt other;
+			other.assignNative(value);
+			*this *= other;
+			return;
+		}
+		if (value.low == 0 || *this == 0) {
+			m_bits.assign(1, 0);
+			m_sign = true;
+			return;
+		}
+		const arrayType carry{ detail::mulSingle(m_bits.data(), m_bits.data(), m_bits.size(), value.low) };
+		if (carry != 0) m_bits.push_back(carry);
+		m_sign = (m_sign != value.negative);
+	}
+
+	void BigInt::divideNative(const detail::NativeInteger& value, bool returnRemainder) {
+		if (value.high != 0) {
+			BigInt other;
+			other.assignNative(value);
+			if (returnRemainder) *this %= other;
+			else *this /= other;
+			return;
+		}
+		//The magnitude of the divisor gives the right remainder whatever its sign, and the quotient only needs negating if it was negative.
+		if (returnRemainder) {
+			*this %= value.low;
+			return;
+		}
+		*this /= value.low;
+		if (value.negative && !(*this == 0)) m_sign = !m_sign;
+	}
+
+	int BigInt::compareNative(const detail::NativeInteger& value) const {
+		//Zero compares by magnitude alone, so that it matches whichever way its sign has been left.
+		const bool valueIsZero{ value.low == 0 && value.high == 0 };
+		if (m_bits.size() == 1 && m_bits[0] == 0) return valueIsZero ? 0 : (value.negative ? 1 : -1);
+		if (m_sign == value.negative) return m_sign ? 1 : -1;
+
+		int magnitude{ 0 };
+		if (m_bits.size() > 2) magnitude = 1;
+		else {
+			const arrayType high{ m_bits.size() == 2 ? m_bits[1] : 0 };
+			if (high != value.high) magnitude = (high < value.high) ? -1 : 1;
+			else if (m_bits[0] != value.low) magnitude = (m_bits[0] < value.low) ? -1 : 1;
+		}
+		return m_sign ? magnitude : -magnitude;
+	}
 
 	/*
 	* CONSTRUCTORS
@@ -149,11 +647,62 @@ namespace dp {
 		m_bits.push_back(0);
 	}
 
+	BigInt::BigInt(const allocator_type& alloc) : m_sign{ true }, m_bits{ alloc.resource() } {
+		m_bits.push_back(0);
+	}
+
+	BigInt::BigInt(const BigInt& inInt, const allocator_type& alloc) : m_sign{ inInt.m_sign }, m_bits{ inInt.m_bits, alloc.resource() } {}
+
+	BigInt::BigInt(BigInt&& inInt, const allocator_type& alloc) : m_sign{ inInt.m_sign }, m_bits{ std::move(inInt.m_bits), alloc.resource() } {}
+
+	BigInt::BigInt(std::string_view inNumber) : BigInt(inNumber, allocator_type{}) {}
+
+	BigInt::BigInt(std::string_view inNumber, const allocator_type& alloc) : BigInt(alloc) {
+		std::string_view digits{ inNumber };
+		bool negative{ false };
+		if (!digits.empty() && (digits.front() == '-' || digits.front() == '+')) {
+			negative = (digits.front() == '-');
+			digits.remove_prefix(1);
+		}
+		int base{ 10 };
+		if (digits.size() > 2 && digits[0] == '0') {
+			if (digits[1] == 'x' || digits[1] == 'X') base = 16;
+			else if (digits[1] == 'b' || digits[1] == 'B') base = 2;
+			if (base != 10) digits.remove_prefix(2);
+		}
+		const char* end{ digits.data() + digits.size() };
+		auto result{ parseMagnitude(digits.data(), end, *this, base) };
+		if (result.ec != std::errc{} || result.ptr != end) {
+			throw std::invalid_argument{ "BigInt: \"" + std::string{ inNumber } + "\" is not a valid integer" };
+		}
+		if (negative && !(*this == 0)) m_sign = false;
+	}
+
 	//In the event that we want to construct from a value which can fit in unsigned unitSize bits, this is trivial.
 	BigInt::BigInt(arrayType inVal, bool sign) : m_sign{ sign } {
 		m_bits.push_back(inVal);
 	}
 
+	BigInt::BigInt(arrayType inVal, bool sign, const allocator_type& alloc) : m_sign{ sign }, m_bits{ alloc.resource() } {
+		m_bits.push_back(inVal);
+	}
+
+	BigInt::BigInt(LimbBuffer&& inLimbs, bool sign) : m_sign{ sign }, m_bits{ std::move(inLimbs) } {
+		trimLeadingZeroes();
+		if (m_bits.back() == 0) m_sign = true;
+	}
+
+
+	InvariantDivisor::InvariantDivisor(std::uint64_t inDivisor) : m_divisor{ inDivisor } {
+		m_shift = static_cast<unsigned>(detail::countLeadingZeros(inDivisor));
+		m_normalised = inDivisor << m_shift;
+		m_reciprocal = detail::reciprocalOf(m_normalised);
+	}
+
+	std::uint64_t InvariantDivisor::value() const {
+		return m_divisor;
+	}
+
 
 	/*
 	* ARITHMETIC OPERATORS
@@ -161,188 +710,46 @@ namespace dp {
 	//Unary minus operator
 	BigInt BigInt::operator-() const {
 		BigInt negativeInt{ *this };
-		negativeInt.m_sign = !m_sign;
+		//Zero stays positive, as it is everywhere else, so that -0 == 0.
+		negativeInt.m_sign = !m_sign || *this == 0;
 		return negativeInt;
 	}
 
 	//Simple addition
 	BigInt BigInt::operator+(const BigInt& inInt) const {
-		//Hurdle 1 - the signs of this and inInt may differ.
-		if (m_sign != inInt.m_sign) {
-			//If this is positive, inInt is negative. A + (-B) for positive A,B = A - B. In code, we can do this as A - |B|.
-			if (m_sign) return (*this - inInt.abs());
-			//Otherwise this is negative, inInt is positive. (-A) + B for positive A,B = B - A. In code, B - |A|.
-			else return(inInt - this->abs());
-		}
-
-		//Hurdle 2 - we cannot necessarily assume the internal vectors for both numbers will be the same.
-		//In addition this is simple to resolve. Our solution will have length equal to the longer operand, but we only need to iterate along the shorter operand to do addition.
-		//The only potential hitch in this plan is overflow. But it is handled internally.
-		BigInt solution{ *this };
-		solution.matchVectorSize(inInt);					//As matchVectorSize will never decrease the size of a vector, this guarantees that solution is the right size.
-		std::size_t smallerSize;
-		std::size_t biggerSize;
-		std::size_t thisSize{ this->m_bits.size() };
-		std::size_t inIntSize{ inInt.m_bits.size() };
-		if (thisSize >= inIntSize) {
-			biggerSize = thisSize;
-			smallerSize = inIntSize;
-		}
-		else {
-			biggerSize = inIntSize;
-			smallerSize = thisSize;
-		}
-		bool overflow{ false };
-		constexpr arrayType	getMostSignificantBit = static_cast<arrayType>(1) << (unitSize - 1);					//Equivalent to 1000000... in binary.
-		constexpr arrayType	removeMostSignificantBit = ~getMostSignificantBit;										//Equivalent to 0111111... in binary
-		//Now the prep work is done we can do addition. The algorithm for this is relatively simple. In cases where the numbers don't overflow the container, solution[i] = a[i] + b[i].
-		//We account for overflow in a bitwise manner. If we separate the most significant bit from each term to be added, add the 31-bit numbers together, and check the unitSizend bit of that solution,
-		//the sum of those three most significant bits will tell you whether the container overflowed, and what state the most significant bit should be in.
-		//In the event of overflow, we just need to add one to the next most significant vector element which can have 1 added without overflowing itself.
-		for (auto i = 0; i < smallerSize; ++i) {
-			//First we separate the most significant bit from the rest of each term.
-			auto term1MostSigBit{ BigInt::getNthBit(solution.m_bits[i],unitSize - 1) };
-			auto term2MostSigBit{ BigInt::getNthBit(inInt.m_bits[i],unitSize - 1) };
-
-			auto term1{ removeMostSignificantBit & solution.m_bits[i] };
-			auto term2{ removeMostSignificantBit & inInt.m_bits[i] };
-
-			//Then we add the terms together and check if they overflowed into the most significant bit.
-			//+= as it's possible this solution term has already been given a value due to overflow on the previous term.
-			solution.m_bits[i] = term1 + term2;
-			auto slnMostSigBit{ BigInt::getNthBit(solution.m_bits[i],unitSize - 1) };
-
-			auto bitSum{ term1MostSigBit + term2MostSigBit + slnMostSigBit };
-
-			//If the three bits sum to bigger than 1, the number overflowed.
-			if (bitSum > 1) {
-				overflow = true;
-				//If it's bigger than 2, we know the most sig bit of our solution's ith arrayType is 1.
-				if (bitSum > 2) {
-					solution.m_bits[i] |= getMostSignificantBit;
-				}
-				//Otherwise we know it must be 0
-				else {
-					solution.m_bits[i] &= ~(getMostSignificantBit);
-				}
-			}
-			//If the three bits are <=1, the most significant bit will be the sum of the three most sig bits.
-			else if (static_cast<int>(slnMostSigBit) != bitSum) {
-				solution.m_bits[i] ^= getMostSignificantBit;
-			}
-
-			//Now all that's left is to deal with overflow.
-			if (overflow) {
-				//As this is effectively a bit array rather than a number, if bits[i] overflows, we only need to add 1 to bits[i+1]. This gives three possible scenarios:
-				//1. It is possible to add 1 to bits[i+1]. In this case that is exactly what we do.
-				//2. bits[i+1] is at the maximum possible value and cannot have 1 added without overflowing itself. In this case we set it to 0 and continue searching for the next term which can have bits added.
-				//3. bits[i] is the most significant term in the final number already. In this case we add an additional term of 1.
-				//Option 2 shouldn't ever happen with how we've set up our system.
-				for (auto j = i; j < biggerSize; ++j) {
-					//First the simplest case to code - if the most significant term in the number overflows, we add a new most significant digit with value 1.
-					if (j == biggerSize - 1) {
-						solution.m_bits.push_back(1);
-						break;
-					}
-					//If the next value up can't be added to without overflowing, we set it to 0 and continue.
-					else if (solution.m_bits[j + 1] == maxBitValue) {
-						solution.m_bits[j + 1] = 0;
-					}
-					//Otherwise we add 1 to the next term up.
-					else {
-						solution.m_bits[j + 1] += 1;
-						break;
-					}
-				}
-				overflow = false;
-			}
-		}
-		solution.trimLeadingZeroes();
+		//Reserve room for a carry before copying, so that the in-place addition never has to reallocate.
+		BigInt solution;
+		solution.m_bits.reserve(std::max(m_bits.size(), inInt.m_bits.size()) + 1);
+		solution.m_bits = m_bits;
+		solution.m_sign = m_sign;
+		solution.addInPlace(inInt, false);
 		return solution;
 	}
 
 	BigInt BigInt::operator-(const BigInt& inInt) const {
-		//Hurdle 1: Crossing 0. Fortunately we can use the anticommutative nature of subtraction to get around this pretty easily.
-		if ((*this) < inInt) {
-			return -(inInt - *this);
-		}
-		//Hurdle 2: Differing signs. Fortunately this is also simple.
-		if (m_sign != inInt.m_sign) {
-			//A - (-1)B = A + B
-			if (m_sign) return (*this) + inInt.abs();
-			//(-1)A - B = -(A + B)
-			else return -(this->abs() + inInt);
-		}
-		//Otherwise subtraction is relatively simple.
-		BigInt solution{ *this };
-		std::size_t thisSize{ this->m_bits.size() };
-		std::size_t inIntSize{ inInt.m_bits.size() };
-		bool carryOver{ false };
-		for (auto i = 0; i < inIntSize; ++i) {			//We know that thisSize >= inIntSize as we know that this >= inInt
-			//Even though the overall this number is smaller than inInt, that does not guarantee that each component of this is smaller than its respective inInt component.
-			//Then we do the easy case of termA > termB and no carryOver
-			if (!carryOver && (this->m_bits[i] >= inInt.m_bits[i]))solution.m_bits[i] -= inInt.m_bits[i];
-			else {
-				//Otherwise, we unfortunately have to do this by bitwise iteration
-				for (auto j = 0; j < unitSize; ++j) {
-					bool term1Bit{ getNthBit(m_bits[i],j) };
-					bool term2Bit{ getNthBit(inInt.m_bits[i],j) };
-
-					auto bitSum{ term1Bit - term2Bit - carryOver };
-					if (bitSum == -2)setNthBit(solution.m_bits[i], j, 0);
-					else setNthBit(solution.m_bits[i], j, ::abs(bitSum));
-
-					if (bitSum < 0)carryOver = true;
-					else carryOver = false;
-				}
-
-			}
-		}
-		//This algorithm should hold even between terms of m_bits,  however there is one edge case - we reach the end of inInt and there's still carryOver.
-		//As we know *this > inInt, this case can only occur when there are additional *this terms to subtract from, and we know that all further inInt terms are implicitly 0.
-		//It is very unlikely that we will go the full length of these loops, as all we want is the first 1 in the binary of *this. But we must account for the fringe case where we don't get it.
-		if (carryOver) {
-			for (auto i = inIntSize; i < thisSize; ++i) {
-				for (auto j = 0; j < unitSize; ++j) {
-					bool term1Bit{ getNthBit(solution.m_bits[i],j) };
-					if (term1Bit) {
-						setNthBit(solution.m_bits[i], j, false);
-						carryOver = false;
-						break;
-					}
-					else {
-						setNthBit(solution.m_bits[i], j, true);
-					}
-				}
-				if (!carryOver)break;
-			}
-		}
+		BigInt solution;
+		solution.m_bits.reserve(std::max(m_bits.size(), inInt.m_bits.size()) + 1);
+		solution.m_bits = m_bits;
+		solution.m_sign = m_sign;
+		solution.addInPlace(inInt, true);
+		return solution;
+	}
 
+	BigInt BigInt::operator*(const BigInt& inInt) const {
+		BigInt solution;
+		//The number of limbs to represent A*B is at most the limbs to represent A + the limbs to represent B, so we allocate that once up front
+		//and let the limb-level multiply fill it in directly.
+		solution.m_bits.resize(m_bits.size() + inInt.m_bits.size());
+		detail::mul(solution.m_bits.data(), m_bits.data(), m_bits.size(), inInt.m_bits.data(), inInt.m_bits.size());
 		solution.trimLeadingZeroes();
+		if (m_sign != inInt.m_sign && !(solution == 0)) solution.m_sign = false;
 		return solution;
 	}
 
-	BigInt BigInt::operator*(const BigInt& inInt) const {
+	BigInt BigInt::square() const {
 		BigInt solution;
-		auto solutionSize{ this->m_bits.size() + inInt.m_bits.size() };
-		//The number of bits to represent A*B = bits to represent A + bits to represent B.
-		solution.matchVectorSize(solutionSize);
-		for (auto i = 0; i < unitSize * m_bits.size(); ++i) {
-			//0 terms in one operand can be skipped.
-			if (this->getTotalNthBit(i)) {
-				BigInt intermediate;
-				//Note we explicitly set intermediate to this and not solution.size() as solution gets all excess zeroes popped off in the += stage.
-				intermediate.matchVectorSize(solutionSize);
-				for (auto j = 0; j < unitSize * inInt.m_bits.size(); ++j) {
-					if (inInt.getTotalNthBit(j)) {
-						intermediate.setTotalNthBit(i + j, true);
-					}
-				}
-				solution += intermediate;
-				solution.matchVectorSize(solutionSize);
-			}
-		}
-		if (m_sign != inInt.m_sign) solution.m_sign = false;
+		solution.m_bits.resize(2 * m_bits.size());
+		detail::sqr(solution.m_bits.data(), m_bits.data(), m_bits.size());
 		solution.trimLeadingZeroes();
 		return solution;
 	}
@@ -350,7 +757,7 @@ namespace dp {
 	BigInt BigInt::operator/(const BigInt& inInt) const {
 		BigInt solution;
 		divide(*this, inInt, solution, false);
-		if (m_sign != inInt.m_sign) solution.m_sign = false;
+		if (m_sign != inInt.m_sign && !(solution == 0)) solution.m_sign = false;
 		return solution;
 	}
 
@@ -358,13 +765,40 @@ namespace dp {
 		BigInt solution;
 		divide(*this, inInt, solution, true);
 		//We follow "truncated modulo" convention for negative signs.
-		if (!m_sign)solution.m_sign = false;
+		if (!m_sign && !(solution == 0))solution.m_sign = false;
 		return solution;
 	}
 
+	BigInt BigInt::operator/(arrayType inDivisor) const {
+		//Division by zero is UB, as with the BigInt overload, so we again leave the solution at 0.
+		if (inDivisor == 0) return BigInt{};
+		BigInt solution{ *this };
+		solution.divideMagnitude(inDivisor);
+		if (solution == 0) solution.m_sign = true;
+		return solution;
+	}
+
+	BigInt BigInt::operator%(arrayType inDivisor) const {
+		if (inDivisor == 0) return BigInt{};
+		arrayType remainder{ detail::divRemSingle(nullptr, m_bits.data(), m_bits.size(), inDivisor) };
+		return BigInt{ remainder, m_sign || remainder == 0 };
+	}
+
+	BigInt BigInt::operator/(const InvariantDivisor& inDivisor) const {
+		BigInt solution{ *this };
+		solution.divideMagnitude(inDivisor);
+		if (solution == 0) solution.m_sign = true;
+		return solution;
+	}
+
+	BigInt BigInt::operator%(const InvariantDivisor& inDivisor) const {
+		arrayType remainder{ detail::divRemPreinverted(nullptr, m_bits.data(), m_bits.size(), inDivisor.m_normalised, inDivisor.m_reciprocal, inDivisor.m_shift) };
+		return BigInt{ remainder, m_sign || remainder == 0 };
+	}
+
 	BigInt& BigInt::operator++() {
 		//We avoid a potentially complex addition algorithm where possible.
-		if (m_bits[0] < std::numeric_limits<arrayType>::max()) {
+		if (m_sign && m_bits[0] < std::numeric_limits<arrayType>::max()) {
 			++m_bits[0];
 			return *this;
 		}
@@ -381,7 +815,7 @@ namespace dp {
 	}
 
 	BigInt& BigInt::operator--() {
-		if (m_bits[0] > 0) {
+		if (m_sign && m_bits[0] > 0) {
 			--m_bits[0];
 			return *this;
 		}
@@ -397,6 +831,265 @@ namespace dp {
 		return copy;
 	}
 
+	void addmul(BigInt& acc, const BigInt& a, const BigInt& b) {
+		const BigInt* longer{ &a };
+		const BigInt* shorter{ &b };
+		if (a.m_bits.size() < b.m_bits.size()) std::swap(longer, shorter);
+		const std::size_t longSize{ longer->m_bits.size() };
+		const std::size_t shortSize{ shorter->m_bits.size() };
+		if (shortSize >= detail::karatsubaThreshold || &acc == &a || &acc == &b) {
+			acc += a * b;
+			return;
+		}
+		if (a == 0 || b == 0) return;
+
+		//Work across enough limbs to hold either acc or the product, plus one for the final carry.
+		const bool productSign{ a.m_sign == b.m_sign };
+		if (acc == 0) acc.m_sign = productSign;
+		const std::size_t width{ std::max(acc.m_bits.size(), longSize + shortSize) + 1 };
+		acc.m_bits.resize(width);
+		BigInt::arrayType* out{ acc.m_bits.data() };
+
+		if (acc.m_sign == productSign) {
+			for (std::size_t i = 0; i < shortSize; ++i) {
+				const BigInt::arrayType carry{ detail::addMulSingle(out + i, longer->m_bits.data(), longSize, shorter->m_bits[i]) };
+				detail::addSingle(out + i + longSize, out + i + longSize, width - i - longSize, carry);
+			}
+		}
+		else {
+			//Subtracting row by row can only pass below zero once. If it does, the limbs hold the two's complement of the result, so we negate them back.
+			bool wrapped{ false };
+			for (std::size_t i = 0; i < shortSize; ++i) {
+				const BigInt::arrayType borrow{ detail::subMulSingle(out + i, longer->m_bits.data(), longSize, shorter->m_bits[i]) };
+				wrapped |= (detail::subSingle(out + i + longSize, out + i + longSize, width - i - longSize, borrow) != 0);
+			}
+			if (wrapped) {
+				for (std::size_t i = 0; i < width; ++i) {
+					out[i] = ~out[i];
+				}
+				detail::addSingle(out, out, width, 1);
+				acc.m_sign = !acc.m_sign;
+			}
+		}
+		acc.trimLeadingZeroes();
+		if (acc == 0) acc.m_sign = true;
+	}
+
+	BigInt pow(const BigInt& base, std::uint64_t exponent) {
+		if (exponent == 0) return BigInt{ 1 };
+		if (base == 0) return BigInt{};
+		//Powers of 1 and -1 would otherwise size their buffers for exponent bits, which for a large exponent is more memory than exists.
+		if (base.m_bits.size() == 1 && base.m_bits[0] == 1) return BigInt{ 1, base.m_sign || (exponent & 1) == 0 };
+
+		//The result has at most exponent times as many bits as the base, so every buffer can be sized once up front. The accumulator and a scratch
+		//buffer then trade places after each step, and nothing is allocated inside the loop.
+		const std::size_t baseSize{ base.m_bits.size() };
+		const std::size_t baseBits{ BigInt::unitSize * baseSize - static_cast<std::size_t>(detail::countLeadingZeros(base.m_bits.back())) };
+		if (baseBits > (std::numeric_limits<std::size_t>::max() - BigInt::unitSize) / exponent) {
+			throw std::length_error{ "pow: the result has too many bits to represent" };
+		}
+		const std::size_t capacity{ baseBits * exponent / BigInt::unitSize + 2 };
+		std::vector<BigInt::arrayType> accumulator(capacity);
+		std::vector<BigInt::arrayType> scratch(capacity);
+		std::size_t accumulatorSize{ 0 };
+
+		//The odd powers base, base^3, base^5, ... for the sliding window, each stepping from the last by base^2.
+		const unsigned window{ detail::exponentWindow(BigInt::unitSize - static_cast<std::size_t>(detail::countLeadingZeros(exponent))) };
+		std::vector<std::vector<BigInt::arrayType>> powers(static_cast<std::size_t>(1) << (window - 1));
+		powers[0].assign(base.m_bits.begin(), base.m_bits.end());
+		if (powers.size() > 1) {
+			std::vector<BigInt::arrayType> baseSquared(2 * baseSize);
+			detail::sqr(baseSquared.data(), base.m_bits.data(), baseSize);
+			trimLimbs(baseSquared);
+			for (std::size_t i = 1; i < powers.size(); ++i) {
+				const std::vector<BigInt::arrayType>& previous{ powers[i - 1] };
+				powers[i].resize(previous.size() + baseSquared.size());
+				detail::mul(powers[i].data(), previous.data(), previous.size(), baseSquared.data(), baseSquared.size());
+				trimLimbs(powers[i]);
+			}
+		}
+
+		auto trimmed = [](const std::vector<BigInt::arrayType>& limbs, std::size_t size) {
+			while (size > 1 && limbs[size - 1] == 0) --size;
+			return size;
+		};
+		detail::slidingWindowExponent(&exponent, 1, window,
+			[&](std::size_t index) {
+				std::copy(powers[index].begin(), powers[index].end(), accumulator.begin());
+				accumulatorSize = powers[index].size();
+			},
+			[&]() {
+				detail::sqr(scratch.data(), accumulator.data(), accumulatorSize);
+				accumulatorSize = trimmed(scratch, 2 * accumulatorSize);
+				accumulator.swap(scratch);
+			},
+			[&](std::size_t index) {
+				detail::mul(scratch.data(), accumulator.data(), accumulatorSize, powers[index].data(), powers[index].size());
+				accumulatorSize = trimmed(scratch, accumulatorSize + powers[index].size());
+				accumulator.swap(scratch);
+			});
+
+		BigInt solution;
+		solution.m_bits.assign(accumulator.data(), accumulator.data() + accumulatorSize);
+		solution.m_sign = base.m_sign || (exponent & 1) == 0;
+		return solution;
+	}
+
+	BigInt powmod(const BigInt& base, const BigInt& exponent, const BigInt& modulus) {
+		if (modulus == 0) throw std::invalid_argument{ "powmod requires a non-zero modulus" };
+		if (!exponent.m_sign) throw std::invalid_argument{ "powmod requires a non-negative exponent" };
+		const BigInt absModulus{ modulus.abs() };
+		if ((absModulus.m_bits[0] & 1) != 0) return MontgomeryContext{ absModulus }.powmod(base, exponent);
+		if (exponent == 0) return BigInt{ 1 };
+
+		//Montgomery reduction needs an odd modulus, so for even ones we fall back to Barrett reduction, which still replaces each long division
+		//with a pair of multiplications against a reciprocal computed once up front.
+		const std::size_t size{ absModulus.m_bits.size() };
+		const BigInt::arrayType* modulusLimbs{ absModulus.m_bits.data() };
+		const std::vector<BigInt::arrayType> mu{ detail::reciprocal(modulusLimbs, size) };
+		BigInt reducedBase{ base % absModulus };
+		if (!reducedBase.m_sign) reducedBase += absModulus;
+
+		std::vector<BigInt::arrayType> accumulator(size);
+		std::vector<BigInt::arrayType> product(2 * size);
+
+		//Every value is kept as size limbs, leading zeroes and all, so any product of two of them is a valid Barrett input.
+		auto reduceProduct = [&](BigInt::arrayType* out) {
+			detail::divRemBarrett(nullptr, out, product.data(), 2 * size, modulusLimbs, size, mu);
+		};
+		const std::size_t exponentBits{ BigInt::unitSize * exponent.m_bits.size() - static_cast<std::size_t>(detail::countLeadingZeros(exponent.m_bits.back())) };
+		const unsigned window{ detail::exponentWindow(exponentBits) };
+		const std::size_t tableSize{ static_cast<std::size_t>(1) << (window - 1) };
+		std::vector<BigInt::arrayType> powers(tableSize * size);
+		std::copy(reducedBase.m_bits.begin(), reducedBase.m_bits.end(), powers.begin());
+		if (tableSize > 1) {
+			std::vector<BigInt::arrayType> baseSquared(size);
+			detail::sqr(product.data(), powers.data(), size);
+			reduceProduct(baseSquared.data());
+			for (std::size_t i = 1; i < tableSize; ++i) {
+				detail::mul(product.data(), powers.data() + (i - 1) * size, size, baseSquared.data(), size);
+				reduceProduct(powers.data() + i * size);
+			}
+		}
+
+		detail::slidingWindowExponent(exponent.m_bits.data(), exponent.m_bits.size(), window,
+			[&](std::size_t index) { std::copy(powers.begin() + index * size, powers.begin() + (index + 1) * size, accumulator.begin()); },
+			[&]() {
+				detail::sqr(product.data(), accumulator.data(), size);
+				reduceProduct(accumulator.data());
+			},
+			[&](std::size_t index) {
+				detail::mul(product.data(), accumulator.data(), size, powers.data() + index * size, size);
+				reduceProduct(accumulator.data());
+			});
+
+		BigInt solution;
+		solution.m_bits.assign(accumulator.data(), accumulator.data() + size);
+		solution.trimLeadingZeroes();
+		return solution;
+	}
+
+	BigInt gcd(const BigInt& a, const BigInt& b) {
+		if (a == 0) return b.abs();
+		if (b == 0) return a.abs();
+		BigInt solution;
+		solution.m_bits.resize(std::min(a.m_bits.size(), b.m_bits.size()));
+		solution.m_bits.resize(detail::gcd(solution.m_bits.data(), a.m_bits.data(), a.m_bits.size(), b.m_bits.data(), b.m_bits.size()));
+		return solution;
+	}
+
+	BigInt lcm(const BigInt& a, const BigInt& b) {
+		if (a == 0 || b == 0) return BigInt{};
+		BigInt solution{ a.abs() / gcd(a, b) };
+		solution *= b.abs();
+		return solution;
+	}
+
+	std::tuple<BigInt, BigInt, BigInt> gcdExtended(const BigInt& a, const BigInt& b) {
+		if (b == 0) return { a.abs(), BigInt{ a == 0 ? 0u : 1u, a.m_sign }, BigInt{} };
+		if (a == 0) return { b.abs(), BigInt{}, BigInt{ 1, b.m_sign } };
+
+		//u and v run through the remainders of Euclid's algorithm on |a| and |b|, and x0 and x1 are the multiples of |a| which are congruent to them
+		//modulo |b|. Each Lehmer step moves both pairs on by the same matrix, and only when it can't be used do we take a full division.
+		BigInt u{ a.abs() };
+		BigInt v{ b.abs() };
+		BigInt x0{ 1 };
+		BigInt x1{};
+		std::vector<BigInt::arrayType> scratch;
+		auto scaled = [](const BigInt& x, std::int64_t factor) {
+			const BigInt::arrayType magnitude{ factor < 0 ? 0 - static_cast<BigInt::arrayType>(factor) : static_cast<BigInt::arrayType>(factor) };
+			return x * BigInt{ magnitude, factor >= 0 };
+		};
+		while (!(v == 0)) {
+			detail::LehmerMatrix m{ 1, 0, 0, 1 };
+			if (u >= v) m = detail::lehmerMatrix(u.m_bits.data(), u.m_bits.size(), v.m_bits.data(), v.m_bits.size());
+			if (m.b == 0) {
+				auto [quotient, remainder] { divmod(u, v) };
+				u = std::move(v);
+				v = std::move(remainder);
+				x0 -= quotient * x1;
+				std::swap(x0, x1);
+			}
+			else {
+				const std::size_t size{ u.m_bits.size() };
+				v.m_bits.resize(size);
+				scratch.resize(2 * size + 2);
+				detail::lehmerUpdate(u.m_bits.data(), v.m_bits.data(), size, m, scratch.data());
+				u.trimLeadingZeroes();
+				v.trimLeadingZeroes();
+				BigInt nextX0{ scaled(x0, m.a) + scaled(x1, m.b) };
+				x1 = scaled(x0, m.c) + scaled(x1, m.d);
+				x0 = std::move(nextX0);
+			}
+		}
+
+		//|a| * x0 is congruent to the gcd modulo |b|, so the matching y is exact.
+		BigInt y{ (u - a.abs() * x0) / b.abs() };
+		if (!a.m_sign && !(x0 == 0)) x0.m_sign = !x0.m_sign;
+		if (!b.m_sign && !(y == 0)) y.m_sign = !y.m_sign;
+		return { std::move(u), std::move(x0), std::move(y) };
+	}
+
+	BigInt modInverse(const BigInt& a, const BigInt& modulus) {
+		if (modulus == 0) throw std::invalid_argument{ "modInverse requires a non-zero modulus" };
+		auto [divisor, inverse, unused] { gcdExtended(a, modulus) };
+		if (!(divisor == 1)) throw std::invalid_argument{ "modInverse requires a value coprime to the modulus" };
+		inverse %= modulus.abs();
+		if (!inverse.m_sign) inverse += modulus.abs();
+		return inverse;
+	}
+
+	BigInt isqrt(const BigInt& x) {
+		return iroot(x, 2);
+	}
+
+	BigInt iroot(const BigInt& x, std::uint64_t n) {
+		if (n == 0) throw std::invalid_argument{ "iroot requires n > 0" };
+		if (!x.m_sign && (n & 1) == 0) throw std::invalid_argument{ "iroot cannot take an even root of a negative value" };
+		const std::size_t bits{ BigInt::unitSize * x.m_bits.size() - static_cast<std::size_t>(detail::countLeadingZeros(x.m_bits.back() | 1)) };
+		if (n == 1 || x == 0) return x;
+		//A value of fewer than n bits is below 2^n, so its root is 1.
+		if (n >= bits) return BigInt{ 1, x.m_sign };
+		BigInt root{ rootMagnitude(x.abs(), bits, n) };
+		root.m_sign = x.m_sign;
+		return root;
+	}
+
+	bool isPerfectSquare(const BigInt& x) {
+		if (!x.m_sign) return false;
+		//Only 12 of the 64 residues mod 64 are squares, and around one in thirty of what is left survives the residues mod 63, 11 and 17.
+		constexpr std::uint64_t residues64{ squareResidues(64) };
+		constexpr std::uint64_t residues63{ squareResidues(63) };
+		constexpr std::uint64_t residues11{ squareResidues(11) };
+		constexpr std::uint64_t residues17{ squareResidues(17) };
+		if (((residues64 >> (x.m_bits[0] & 63)) & 1) == 0) return false;
+		const BigInt::arrayType remainder{ static_cast<BigInt::arrayType>(x % static_cast<BigInt::arrayType>(63 * 11 * 17)) };
+		if (((residues63 >> (remainder % 63)) & 1) == 0) return false;
+		if (((residues11 >> (remainder % 11)) & 1) == 0) return false;
+		if (((residues17 >> (remainder % 17)) & 1) == 0) return false;
+		return isqrt(x).square() == x;
+	}
+
 	BigInt operator+(BigInt::arrayType inUInt, const BigInt& inInt) {
 		return inInt + inUInt;
 	}
@@ -405,6 +1098,46 @@ namespace dp {
 		return inInt * inUInt;
 	}
 
+	std::pair<BigInt, BigInt> divmod(const BigInt& dividend, const BigInt& divisor) {
+		if (divisor.canBeShortened()) {
+			auto solution{ divmod(dividend, divisor.m_bits[0]) };
+			if (!divisor.m_sign && !(solution.first == 0)) solution.first.m_sign = !solution.first.m_sign;
+			return solution;
+		}
+		std::pair<BigInt, BigInt> solution;
+		auto& [quotient, remainder] { solution };
+		const auto& dividendBits{ dividend.m_bits };
+		const auto& divisorBits{ divisor.m_bits };
+		if (detail::compare(dividendBits.data(), dividendBits.size(), divisorBits.data(), divisorBits.size()) < 0) {
+			remainder = dividend;
+			return solution;
+		}
+		quotient.m_bits.resize(dividendBits.size() - divisorBits.size() + 1);
+		remainder.m_bits.resize(divisorBits.size());
+		detail::divRem(quotient.m_bits.data(), remainder.m_bits.data(), dividendBits.data(), dividendBits.size(), divisorBits.data(), divisorBits.size());
+		quotient.trimLeadingZeroes();
+		remainder.trimLeadingZeroes();
+		//The same sign conventions as operator/ and operator%
+		if (dividend.m_sign != divisor.m_sign && !(quotient == 0)) quotient.m_sign = false;
+		if (!dividend.m_sign && !(remainder == 0)) remainder.m_sign = false;
+		return solution;
+	}
+
+	std::pair<BigInt, BigInt> divmod(const BigInt& dividend, BigInt::arrayType divisor) {
+		if (divisor == 0) return {};
+		BigInt quotient{ dividend };
+		BigInt::arrayType remainder{ quotient.divideMagnitude(divisor) };
+		if (quotient == 0) quotient.m_sign = true;
+		return { std::move(quotient), BigInt{ remainder, dividend.m_sign || remainder == 0 } };
+	}
+
+	std::pair<BigInt, BigInt> divmod(const BigInt& dividend, const InvariantDivisor& divisor) {
+		BigInt quotient{ dividend };
+		BigInt::arrayType remainder{ quotient.divideMagnitude(divisor) };
+		if (quotient == 0) quotient.m_sign = true;
+		return { std::move(quotient), BigInt{ remainder, dividend.m_sign || remainder == 0 } };
+	}
+
 	/*
 	* COMPARISON OPERATORS
 	*/
@@ -421,7 +1154,8 @@ namespace dp {
 	//We include a "shortcut" equality operator for cases such as division where we need to ensure we're not dividing by zero.
 	bool BigInt::operator==(arrayType inInt) const {
 		if (m_bits.size() != 1) return false;
-		return(m_bits[0] == inInt);
+		//Zero matches whichever way its sign has been left, so that this can be used to tidy up a sign after the fact.
+		return (m_bits[0] == inInt) && (m_sign || inInt == 0);
 	}
 
 	bool BigInt::operator!=(const BigInt& inInt) const {
@@ -434,18 +1168,9 @@ namespace dp {
 			if (m_sign) return false;
 			else return true;
 		}
-		std::size_t thisSize{ this->m_bits.size() };
-		std::size_t inIntSize{ inInt.m_bits.size() };
-		if (thisSize < inIntSize) return true;			//Simple check first. If the vectors are of differing sizes it's easy to deduce which represents a larger number.
-		else if (thisSize > inIntSize) return false;
-		//Otherwise we just compare, starting at the most significant value.
-		//As we need indexing for both vectors and can't count down below 0 on an unsigned type, we need to do a slightly weird for loop.
-		for (auto i = 0; i < thisSize; ++i) {
-			if (this->m_bits[thisSize - i - 1] < inInt.m_bits[thisSize - i - 1]) return true;
-			if (this->m_bits[thisSize - i - 1] > inInt.m_bits[thisSize - i - 1]) return false;
-		}
-		//Down here the only possibility is that we have two identical numbers.
-		return false;
+		//With equal signs it comes down to the magnitudes, where for two negative numbers the larger magnitude is the smaller number.
+		const int magnitude{ detail::compare(m_bits.data(), m_bits.size(), inInt.m_bits.data(), inInt.m_bits.size()) };
+		return m_sign ? (magnitude < 0) : (magnitude > 0);
 	}
 
 	bool BigInt::operator<=(const BigInt& inInt) const {
@@ -461,173 +1186,235 @@ namespace dp {
 	/*
 	* BITWISE OPERATORS
 	*/
+	//Shifts are done a whole limb at a time, then a single pass funnels the remaining bits across limb boundaries.
+	//As with the built-in types, << keeps to the current width of the number and discards anything shifted past the top. See xLS for a shift which doesn't.
 	BigInt BigInt::operator<<(arrayType inInt) const {
 		if (inInt == 0)return BigInt{ *this };
-
-		auto totalBits{ unitSize * m_bits.size() };
+		const std::size_t size{ m_bits.size() };
 		//If we're shifting by more bits than exist in the BigInt, we return 0;
-		if (inInt >= totalBits) {
-			return BigInt{ 0 };
-		}
-		else {
-			BigInt solution{ *this };
-
-			for (auto i = 0; i < totalBits - inInt; ++i) {
-				solution.setTotalNthBit(totalBits - i - 1, solution.getTotalNthBit(totalBits - i - inInt - 1));
-			}
-			for (auto i = totalBits - inInt; i < totalBits; ++i) {
-				solution.setTotalNthBit(totalBits - i - 1, false);
-			}
-
-			return solution;
-		}
+		if (inInt >= unitSize * size) return BigInt{ 0 };
 
+		const std::size_t limbShift{ static_cast<std::size_t>(inInt / unitSize) };
+		const unsigned bitShift{ static_cast<unsigned>(inInt % unitSize) };
+		BigInt solution;
+		solution.m_bits.resize(size);
+		if (bitShift == 0) std::copy(m_bits.begin(), m_bits.end() - limbShift, solution.m_bits.begin() + limbShift);
+		else detail::shiftLeftBits(solution.m_bits.data() + limbShift, m_bits.data(), size - limbShift, bitShift);
+		solution.trimLeadingZeroes();
+		solution.m_sign = m_sign || solution == 0;
+		return solution;
 	}
 
 	BigInt BigInt::operator>>(arrayType inInt) const {
 		if (inInt == 0)return BigInt{ *this };
+		const std::size_t size{ m_bits.size() };
+		if (inInt >= unitSize * size) return BigInt{ 0 };
 
-		auto totalBits{ unitSize * m_bits.size() };
-		//If we're shifting by more bits than exist in the BigInt, we return 0;
-		if (inInt >= totalBits) {
-			return BigInt{ 0 };
-		}
-		else {
-			BigInt solution{ *this };
-
-			for (auto i = 0; i < totalBits - inInt; ++i) {
-				solution.setTotalNthBit(i, solution.getTotalNthBit(i + inInt));
-			}
-			for (auto i = totalBits - inInt; i < totalBits; ++i) {
-				solution.setTotalNthBit(i, false);
-			}
-
-			return solution;
-		}
+		//Only the limbs which survive the shift are ever copied.
+		const std::size_t limbShift{ static_cast<std::size_t>(inInt / unitSize) };
+		const unsigned bitShift{ static_cast<unsigned>(inInt % unitSize) };
+		BigInt solution;
+		solution.m_bits.resize(size - limbShift);
+		if (bitShift == 0) std::copy(m_bits.begin() + limbShift, m_bits.end(), solution.m_bits.begin());
+		else detail::shiftRightBits(solution.m_bits.data(), m_bits.data() + limbShift, size - limbShift, bitShift);
+		solution.trimLeadingZeroes();
+		solution.m_sign = m_sign || solution == 0;
+		return solution;
+	}
 
+	void BigInt::combineUnequal(BigInt& solution, const BigInt& a, const BigInt& b, void (*op)(arrayType*, const arrayType*, const arrayType*, std::size_t)) {
+		const BigInt& longer{ (a.m_bits.size() >= b.m_bits.size()) ? a : b };
+		const BigInt& shorter{ (a.m_bits.size() >= b.m_bits.size()) ? b : a };
+		const std::size_t shorterSize{ shorter.m_bits.size() };
+		solution.m_bits.resize(longer.m_bits.size());
+		op(solution.m_bits.data(), longer.m_bits.data(), shorter.m_bits.data(), shorterSize);
+		std::copy(longer.m_bits.begin() + shorterSize, longer.m_bits.end(), solution.m_bits.begin() + shorterSize);
+		solution.trimLeadingZeroes();
+		solution.m_sign = (a.m_sign == b.m_sign) || solution == 0;
 	}
 
+	//The binary forms write their result straight into a new BigInt rather than copying one operand and then combining the other into it.
 	BigInt BigInt::operator&(const BigInt& inInt) const {
-		BigInt solution{ *this };
-		(m_sign != inInt.m_sign) ? solution.m_sign = false : solution.m_sign = true;
-		solution.matchVectorSize(inInt);
-		//Account for possible differing vector sizes.
-		std::size_t smallerSize{ inInt.m_bits.size() };
-		std::size_t biggerSize{ m_bits.size() };
-		if (m_bits.size() < inInt.m_bits.size()) {
-			smallerSize = m_bits.size();
-			biggerSize = inInt.m_bits.size();
-		}
-		for (auto i = 0; i < smallerSize; ++i) {
-			solution.m_bits[i] &= inInt.m_bits[i];
-		}
-		//And set any leading terms to 0, as anything & 0 = 0.
-		for (auto i = smallerSize; i < biggerSize; ++i) {
-			solution.m_bits[i] = 0;
-		}
+		BigInt solution;
+		const std::size_t smallerSize{ std::min(m_bits.size(), inInt.m_bits.size()) };
+		solution.m_bits.resize(smallerSize);
+		detail::andSame(solution.m_bits.data(), m_bits.data(), inInt.m_bits.data(), smallerSize);
 		solution.trimLeadingZeroes();
+		solution.m_sign = (m_sign == inInt.m_sign) || solution == 0;
 		return solution;
 	}
 
 	BigInt BigInt::operator|(const BigInt& inInt) const {
-		BigInt solution{ *this };
-		(m_sign != inInt.m_sign) ? solution.m_sign = false : solution.m_sign = true;
-		solution.matchVectorSize(inInt);
-		//Account for possible differing vector sizes.
-		std::size_t smallerSize{ inInt.m_bits.size() };
-		std::size_t biggerSize{ m_bits.size() };
-		bool thisBigger{ true };
-		if (m_bits.size() < inInt.m_bits.size()) {
-			smallerSize = m_bits.size();
-			biggerSize = inInt.m_bits.size();
-			thisBigger = false;
-		}
-		for (auto i = 0; i < smallerSize; ++i) {
-			solution.m_bits[i] |= inInt.m_bits[i];
-		}
-		//We have two possibilities. 
-		// this > inInt means that Solution also contains all leading terms and using operator| is equivalent to adding 0.
-		// The reverse means that there are still terms left to add. Since in this case leading solution terms are set to 0, we can add without risk of overflow.
-		if (!thisBigger) {
-			for (auto i = smallerSize; i < biggerSize; ++i) {
-				solution.m_bits[i] += inInt.m_bits[i];
-			}
-		}
-		solution.trimLeadingZeroes();
+		BigInt solution;
+		combineUnequal(solution, *this, inInt, detail::orSame);
 		return solution;
 	}
 
 	BigInt BigInt::operator^(const BigInt& inInt) const {
-		BigInt solution{ *this };
-		(m_sign != inInt.m_sign) ? solution.m_sign = false : solution.m_sign = true;
-		solution.matchVectorSize(inInt);
-		//Account for possible differing vector sizes.
-		std::size_t smallerSize{ inInt.m_bits.size() };
-		std::size_t biggerSize{ m_bits.size() };
-		bool thisBigger{ true };
-		if (m_bits.size() < inInt.m_bits.size()) {
-			smallerSize = m_bits.size();
-			biggerSize = inInt.m_bits.size();
-			thisBigger = false;
-		}
-		for (auto i = 0; i < smallerSize; ++i) {
-			solution.m_bits[i] ^= inInt.m_bits[i];
-		}
-		//Again if this < inInt we need to plug solution with (inInt ^ 0) terms
-		if (!thisBigger) {
-			for (auto i = smallerSize; i < biggerSize; ++i) {
-				solution.m_bits[i] = inInt.m_bits[i] ^ static_cast<arrayType>(0);
-			}
-		}
-		//Otherwise solution already contains the pertinent data and we just need to ^0 it.
-		else {
-			for (auto i = smallerSize; i < biggerSize; ++i) {
-				solution.m_bits[i] ^= static_cast<arrayType>(0);
-			}
-		}
-		solution.trimLeadingZeroes();
+		BigInt solution;
+		combineUnequal(solution, *this, inInt, detail::xorSame);
 		return solution;
 	}
 
 	BigInt BigInt::operator~() const {
-		BigInt solution{ *this };
-		for (auto i = 0; i < solution.m_bits.size(); ++i) {
-			solution.m_bits[i] = ~(solution.m_bits[i]);
-		}
+		BigInt solution;
+		solution.m_bits.resize(m_bits.size());
+		detail::complement(solution.m_bits.data(), m_bits.data(), m_bits.size());
 		solution.trimLeadingZeroes();
+		solution.m_sign = m_sign || solution == 0;
 		return solution;
 	}
 
 	
 	BigInt BigInt::xLS(arrayType inInt) const {
-		auto extraTermsNeeded{ ((inInt) / unitSize) + 1 };		
-		BigInt solution{ *this };		
-		if (extraTermsNeeded > 0) {
-			solution.m_bits.reserve(solution.m_bits.size() + extraTermsNeeded);
-			for (auto i = 0; i < extraTermsNeeded; ++i) {
-				solution.m_bits.push_back(0);
-			}
+		//The result needs one limb for each whole limb of the shift, plus one more to catch the bits funnelled out of the top.
+		const std::size_t size{ m_bits.size() };
+		const std::size_t limbShift{ static_cast<std::size_t>(inInt / unitSize) };
+		const unsigned bitShift{ static_cast<unsigned>(inInt % unitSize) };
+		BigInt solution;
+		solution.m_bits.resize(size + limbShift + 1);
+		if (bitShift == 0) std::copy(m_bits.begin(), m_bits.end(), solution.m_bits.begin() + limbShift);
+		else solution.m_bits[size + limbShift] = detail::shiftLeftBits(solution.m_bits.data() + limbShift, m_bits.data(), size, bitShift);
+		solution.trimLeadingZeroes();
+		solution.m_sign = m_sign || solution == 0;
+		return solution;
+	}
+
+	/*
+	* BIT ACCESS
+	*/
+	std::size_t BigInt::bitLength() const {
+		//The top limb is only ever zero for zero itself.
+		if (m_bits.back() == 0) return 0;
+		return unitSize * m_bits.size() - static_cast<std::size_t>(detail::countLeadingZeros(m_bits.back()));
+	}
+
+	std::size_t BigInt::popcount() const {
+		return detail::popcount(m_bits.data(), m_bits.size());
+	}
+
+	std::size_t BigInt::lowestSetBit() const {
+		if (m_bits.back() == 0) return std::numeric_limits<std::size_t>::max();
+		return detail::countTrailingZeros(m_bits.data(), m_bits.size());
+	}
+
+	bool BigInt::testBit(std::size_t n) const {
+		const std::size_t limb{ n / unitSize };
+		return limb < m_bits.size() && getNthBit(m_bits[limb], n % unitSize);
+	}
+
+	void BigInt::setBit(std::size_t n, bool value) {
+		const std::size_t limb{ n / unitSize };
+		if (limb >= m_bits.size()) {
+			if (!value) return;
+			m_bits.resize(limb + 1);
+		}
+		setNthBit(m_bits[limb], n % unitSize, value);
+		//Clearing the top bit may leave leading zero limbs, or leave us at zero, which is always positive.
+		if (!value && limb + 1 == m_bits.size()) {
+			trimLeadingZeroes();
+			if (*this == 0) m_sign = true;
 		}
-		solution <<= inInt;
+	}
+
+	const detail::LimbBuffer& BigInt::limbs() const {
+		return m_bits;
+	}
+
+	BigInt::LimbBuffer BigInt::releaseLimbs() {
+		//Moving out leaves our buffer empty but still on the same resource.
+		LimbBuffer released{ std::move(m_bits) };
+		m_bits.push_back(0);
+		m_sign = true;
+		return released;
+	}
+
+	/*
+	* BINARY SERIALISATION
+	*/
+	std::size_t BigInt::byteLength() const {
+		return (bitLength() + 7) / 8;
+	}
+
+	std::uint8_t* BigInt::exportBytes(std::uint8_t* out, ByteOrder order) const {
+		const std::size_t length{ byteLength() };
+		if (order == ByteOrder::little) storeBytes<ByteOrder::little>(m_bits.data(), length, out);
+		else storeBytes<ByteOrder::big>(m_bits.data(), length, out);
+		return out + length;
+	}
+
+	std::vector<std::uint8_t> BigInt::exportBytes(ByteOrder order) const {
+		std::vector<std::uint8_t> bytes(byteLength());
+		exportBytes(bytes.data(), order);
+		return bytes;
+	}
+
+	BigInt BigInt::importBytes(const std::uint8_t* data, std::size_t size, ByteOrder order) {
+		BigInt solution;
+		if (order == ByteOrder::little) loadBytes<ByteOrder::little>(data, size, solution.m_bits);
+		else loadBytes<ByteOrder::big>(data, size, solution.m_bits);
 		solution.trimLeadingZeroes();
 		return solution;
 	}
 
+	std::size_t BigInt::serialisedSize() const {
+		const std::size_t length{ byteLength() };
+		return varintSize(2 * length + (m_sign ? 0 : 1)) + length;
+	}
+
+	std::uint8_t* BigInt::serialise(std::uint8_t* out) const {
+		const std::size_t length{ byteLength() };
+		out = writeVarint(2 * length + (m_sign ? 0 : 1), out);
+		storeBytes<ByteOrder::little>(m_bits.data(), length, out);
+		return out + length;
+	}
+
+	std::vector<std::uint8_t> BigInt::serialise() const {
+		std::vector<std::uint8_t> bytes(serialisedSize());
+		serialise(bytes.data());
+		return bytes;
+	}
+
+	const std::uint8_t* BigInt::deserialise(const std::uint8_t* first, const std::uint8_t* last, BigInt& value) {
+		std::size_t header{ 0 };
+		const std::uint8_t* bytes{ readVarint(first, last, header) };
+		if (bytes == nullptr) return nullptr;
+		const std::size_t length{ header >> 1 };
+		if (length > static_cast<std::size_t>(last - bytes)) return nullptr;
+
+		loadBytes<ByteOrder::little>(bytes, length, value.m_bits);
+		value.trimLeadingZeroes();
+		//A negative zero can only come from a hand-made header, and is read as zero like any other.
+		value.m_sign = (header & 1) == 0 || value.m_bits.back() == 0;
+		return bytes + length;
+	}
+
 	/*
 	* ASSIGNMENT OPERATORS
 	*/
 	BigInt& BigInt::operator+=(const BigInt& inInt) {
-		*this = *this + inInt;
+		addInPlace(inInt, false);
 		return *this;
 	}
 
 	BigInt& BigInt::operator-=(const BigInt& inInt) {
-		*this = *this - inInt;
+		addInPlace(inInt, true);
 		return *this;
 	}
 
 	BigInt& BigInt::operator*=(const BigInt& inInt) {
-		*this = *this * inInt;
+		//A product can't be written over its own operands, so it is formed in a per-thread scratch buffer which then trades places with m_bits.
+		//The old limbs become the next scratch buffer, so a loop of repeated multiplications settles into reusing the same two allocations, at least
+		//up to productScratchLimit limbs.
+		detail::LimbBuffer& product{ productScratch() };
+		product.resize(m_bits.size() + inInt.m_bits.size());
+		detail::mul(product.data(), m_bits.data(), m_bits.size(), inInt.m_bits.data(), inInt.m_bits.size());
+		//Swapping would hand our limbs to the scratch buffer's resource, so a BigInt with a resource of its own has the product copied back instead.
+		if (m_bits.resource() == product.resource()) m_bits.swap(product);
+		else m_bits.assign(product.data(), product.data() + product.size());
+		releaseLargeScratch(product);
+		trimLeadingZeroes();
+		m_sign = (m_sign == inInt.m_sign) || (*this == 0);
 		return *this;
 	}
 
@@ -641,28 +1428,90 @@ namespace dp {
 		return *this;
 	}
 
+	BigInt& BigInt::operator/=(arrayType inDivisor) {
+		if (inDivisor == 0) return *this = BigInt{};
+		divideMagnitude(inDivisor);
+		if (*this == 0) m_sign = true;
+		return *this;
+	}
+
+	BigInt& BigInt::operator%=(arrayType inDivisor) {
+		if (inDivisor == 0) return *this = BigInt{};
+		const arrayType remainder{ detail::divRemSingle(nullptr, m_bits.data(), m_bits.size(), inDivisor) };
+		m_bits.resize(1);
+		m_bits[0] = remainder;
+		if (remainder == 0) m_sign = true;
+		return *this;
+	}
+
 	BigInt& BigInt::operator<<=(arrayType inInt) {
-		*this = *this << inInt;
+		if (inInt == 0) return *this;
+		const std::size_t size{ m_bits.size() };
+		if (inInt >= unitSize * size) {
+			m_bits.assign(1, 0);
+			m_sign = true;
+			return *this;
+		}
+
+		//Move the limbs up first, then the bit shift can work in place over the part that's left.
+		const std::size_t limbShift{ static_cast<std::size_t>(inInt / unitSize) };
+		const unsigned bitShift{ static_cast<unsigned>(inInt % unitSize) };
+		if (limbShift != 0) {
+			std::memmove(m_bits.data() + limbShift, m_bits.data(), (size - limbShift) * sizeof(arrayType));
+			std::fill(m_bits.begin(), m_bits.begin() + limbShift, 0);
+		}
+		if (bitShift != 0) detail::shiftLeftBits(m_bits.data() + limbShift, m_bits.data() + limbShift, size - limbShift, bitShift);
+		trimLeadingZeroes();
+		if (*this == 0) m_sign = true;
 		return *this;
 	}
 
 	BigInt& BigInt::operator>>=(arrayType inInt) {
-		*this = *this >> inInt;
+		if (inInt == 0) return *this;
+		const std::size_t size{ m_bits.size() };
+		if (inInt >= unitSize * size) {
+			m_bits.assign(1, 0);
+			m_sign = true;
+			return *this;
+		}
+
+		const std::size_t limbShift{ static_cast<std::size_t>(inInt / unitSize) };
+		const unsigned bitShift{ static_cast<unsigned>(inInt % unitSize) };
+		if (limbShift != 0) std::memmove(m_bits.data(), m_bits.data() + limbShift, (size - limbShift) * sizeof(arrayType));
+		if (bitShift != 0) detail::shiftRightBits(m_bits.data(), m_bits.data(), size - limbShift, bitShift);
+		m_bits.resize(size - limbShift);
+		trimLeadingZeroes();
+		if (*this == 0) m_sign = true;
 		return *this;
 	}
 
 	BigInt& BigInt::operator&=(const BigInt& inInt) {
-		*this = *this & inInt;
+		//Any limbs past the end of the shorter operand are & 0 = 0, so we can drop them before we start.
+		const std::size_t smallerSize{ std::min(m_bits.size(), inInt.m_bits.size()) };
+		m_bits.resize(smallerSize);
+		detail::andSame(m_bits.data(), m_bits.data(), inInt.m_bits.data(), smallerSize);
+		trimLeadingZeroes();
+		m_sign = (m_sign == inInt.m_sign) || *this == 0;
 		return *this;
 	}
 
 	BigInt& BigInt::operator|=(const BigInt& inInt) {
-		*this = *this | inInt;
+		//Limbs past the end of inInt are | 0, which leaves them unchanged, so only inInt's limbs need visiting.
+		const std::size_t inIntSize{ inInt.m_bits.size() };
+		if (m_bits.size() < inIntSize) m_bits.resize(inIntSize);
+		detail::orSame(m_bits.data(), m_bits.data(), inInt.m_bits.data(), inIntSize);
+		trimLeadingZeroes();
+		m_sign = (m_sign == inInt.m_sign) || *this == 0;
 		return *this;
 	}
 
 	BigInt& BigInt::operator^=(const BigInt& inInt) {
-		*this = *this ^ inInt;
+		//Again limbs past the end of inInt are ^ 0 and unchanged.
+		const std::size_t inIntSize{ inInt.m_bits.size() };
+		if (m_bits.size() < inIntSize) m_bits.resize(inIntSize);
+		detail::xorSame(m_bits.data(), m_bits.data(), inInt.m_bits.data(), inIntSize);
+		trimLeadingZeroes();
+		m_sign = (m_sign == inInt.m_sign) || *this == 0;
 		return *this;
 	}
 
@@ -674,6 +1523,10 @@ namespace dp {
 		return m_sign;
 	}
 
+	BigInt::allocator_type BigInt::get_allocator() const {
+		return allocator_type{ m_bits.resource() };
+	}
+
 	BigInt BigInt::abs() const {
 		BigInt absValue{ *this };
 		absValue.m_sign = true;
@@ -690,17 +1543,107 @@ namespace dp {
 	}
 
 	std::string BigInt::toString(int base) const {
+		std::size_t digitBound{};
 		switch (base) {
 		case 2:
-			return this->getBinaryString();
+			digitBound = unitSize * m_bits.size();
+			break;
 		case 10:
-			return this->getDecimalString();
-
-			//More bases to be added as needed.
+			digitBound = decimalLengthBound(m_bits.size());
+			break;
+		case 16:
+			digitBound = unitSize / 4 * m_bits.size();
+			break;
 		default:
-			std::cout << "Base " << base << " is not currently supported. Returning base-10.\n";
-			return this->getDecimalString();
+			throw std::invalid_argument{ "BigInt: base " + std::to_string(base) + " is not supported" };
+		}
+		//One more character for the sign.
+		std::string output(digitBound + 1, '\0');
+		auto result{ toChars(output.data(), output.data() + output.size(), base) };
+		output.resize(static_cast<std::size_t>(result.ptr - output.data()));
+		return output;
+	}
+
+	std::from_chars_result BigInt::fromChars(const char* first, const char* last, BigInt& value, int base) {
+		const bool negative{ first != last && *first == '-' };
+		auto result{ parseMagnitude(first + negative, last, value, base) };
+		if (result.ec != std::errc{}) return { first, result.ec };
+		if (negative && !(value == 0)) value.m_sign = false;
+		return result;
+	}
+
+	std::from_chars_result BigInt::parseMagnitude(const char* first, const char* last, BigInt& value, int base) {
+		if (base != 2 && base != 10 && base != 16) return { first, std::errc::invalid_argument };
+		const char* end{ first };
+		while (end != last && isDigit(*end, base)) ++end;
+		if (end == first) return { first, std::errc::invalid_argument };
+
+		const std::string_view digits{ first, static_cast<std::size_t>(end - first) };
+		std::vector<limb_type> limbs{};
+		if (base == 10) {
+			//log2(10) < 3.33, so each digit takes fewer than 213/64 limbs; which gives a bound on the size of the powers we need.
+			limbs = (digits.size() < decimalSplitThreshold * digitsPerChunk) ? parseDecimalBasecase(digits)
+				: parseDecimal(digits, decimalPowers(digits.size() * 213 / 4096 + 1, false));
+		}
+		else {
+			limbs = parsePowerOfTwo(digits, (base == 2) ? 1 : 4);
+		}
+
+		if (limbs.empty()) limbs.push_back(0);
+		value.m_bits.assign(limbs.data(), limbs.data() + limbs.size());
+		value.m_sign = true;
+		return { end, std::errc{} };
+	}
+
+	void BigInt::setMultiplyThreads(unsigned count) {
+		detail::setMultiplyThreads(count);
+	}
+
+	unsigned BigInt::multiplyThreads() {
+		return detail::multiplyThreads();
+	}
+
+	std::to_chars_result BigInt::toChars(char* first, char* last, int base) const {
+		if (base != 2 && base != 10 && base != 16) return { last, std::errc::invalid_argument };
+		if (first == last) return { last, std::errc::value_too_large };
+		if (*this == 0) {
+			*first = '0';
+			return { first + 1, std::errc{} };
+		}
+		if (!m_sign) {
+			*first++ = '-';
+		}
+		const std::size_t available{ static_cast<std::size_t>(last - first) };
+
+		//Power of two bases need no arithmetic, as each digit is a fixed group of bits within a single limb.
+		if (base != 10) {
+			const std::size_t bitsPerDigit{ (base == 2) ? 1u : 4u };
+			const std::size_t totalBits{ unitSize * m_bits.size() - static_cast<std::size_t>(detail::countLeadingZeros(m_bits.back())) };
+			const std::size_t digits{ (totalBits + bitsPerDigit - 1) / bitsPerDigit };
+			if (digits > available) return { last, std::errc::value_too_large };
+			const arrayType digitMask{ (static_cast<arrayType>(1) << bitsPerDigit) - 1 };
+			for (std::size_t i = 0; i < digits; ++i) {
+				const std::size_t bitIndex{ (digits - 1 - i) * bitsPerDigit };
+				first[i] = "0123456789abcdef"[(m_bits[bitIndex / unitSize] >> (bitIndex % unitSize)) & digitMask];
+			}
+			return { first + digits, std::errc{} };
+		}
+
+		//Decimal digits come out least significant first, so we write them right-aligned against an upper bound on their length and then move them
+		//down into place. If the caller's range can't hold that upper bound we work in a temporary buffer instead.
+		const std::size_t bound{ decimalLengthBound(m_bits.size()) };
+		std::string temporary{};
+		char* end{ first + bound };
+		if (bound > available) {
+			temporary.resize(bound);
+			end = temporary.data() + bound;
 		}
+		std::vector<limb_type> limbs(m_bits.begin(), m_bits.end());
+		const char* start{ (limbs.size() < decimalSplitThreshold) ? writeDecimalBasecase(std::move(limbs), end, 0) : writeDecimal(limbs, end, decimalPowers(limbs.size())) };
+		const std::size_t digits{ static_cast<std::size_t>(end - start) };
+		if (digits > available) return { last, std::errc::value_too_large };
+		std::memmove(first, start, digits);
+		return { first + digits, std::errc{} };
 	}
 
 }
\ No newline at end of file
@@ -0,0 +1,1271 @@
+#include "BigIntKernels.h"
+
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <thread>
+
+//Helpers for splitting the work of a multiplication between threads. Work is forked with std::async and joined before returning, so a multiplication
+//never leaves anything running behind it, and an exception thrown on any thread is rethrown on the calling one.
+namespace {
+
+	std::atomic<unsigned> multiplyThreadCount{ 1 };
+
+	//Runs every task, each of which is handed the number of threads it may use for forks of its own. The tasks are dealt out between up to threads
+	//threads, the calling thread among them, and any threads beyond one per task are shared between the tasks.
+	template<typename... Tasks>
+	void parallelInvoke(unsigned threads, Tasks&&... tasks) {
+		if (threads <= 1) {
+			(tasks(1u), ...);
+			return;
+		}
+		const std::array<std::function<void(unsigned)>, sizeof...(Tasks)> list{ std::forward<Tasks>(tasks)... };
+		const unsigned groups{ std::min(threads, static_cast<unsigned>(list.size())) };
+		auto runGroup = [&list, threads, groups](unsigned group) {
+			const unsigned share{ threads / groups + (group < threads % groups ? 1 : 0) };
+			for (std::size_t i = group; i < list.size(); i += groups) list[i](share);
+		};
+		std::vector<std::future<void>> forks;
+		for (unsigned group = 1; group < groups; ++group) {
+			forks.push_back(std::async(std::launch::async, runGroup, group));
+		}
+		runGroup(0);
+		for (auto& fork : forks) fork.get();
+	}
+
+	//Calls body(begin, end) over consecutive ranges covering [0, count), with one range for each of up to threads threads.
+	template<typename Body>
+	void parallelFor(unsigned threads, std::size_t count, Body&& body) {
+		const std::size_t pieces{ std::min<std::size_t>(std::max(threads, 1u), count) };
+		if (pieces <= 1) {
+			if (count != 0) body(std::size_t{ 0 }, count);
+			return;
+		}
+		std::vector<std::future<void>> forks;
+		for (std::size_t piece = 1; piece < pieces; ++piece) {
+			forks.push_back(std::async(std::launch::async, [&body, begin = count * piece / pieces, end = count * (piece + 1) / pieces]() { body(begin, end); }));
+		}
+		body(std::size_t{ 0 }, count / pieces);
+		for (auto& fork : forks) fork.get();
+	}
+}
+
+//Helpers for the recursive multiplication algorithms which are not needed outside of this file.
+namespace {
+
+	using dp::detail::limb_type;
+
+	//out[0..xn) = |x[0..xn) - y[0..yn)| for xn >= yn. Returns true if the difference was negative (i.e. y > x).
+	bool absDifference(limb_type* out, const limb_type* x, std::size_t xn, const limb_type* y, std::size_t yn) {
+		if (dp::detail::compare(x, xn, y, yn) >= 0) {
+			dp::detail::subUnequal(out, x, xn, y, yn);
+			return false;
+		}
+		//If y > x then x's limbs above yn must all be zero, so only the bottom yn limbs take part.
+		dp::detail::subSame(out, y, x, yn);
+		std::fill(out + yn, out + xn, 0);
+		return true;
+	}
+
+	//The intermediate values in Toom-Cook can go negative, so we hold them as a sign and a magnitude.
+	struct SignedLimbs {
+		std::vector<limb_type> limbs;		//Little-endian magnitude with no leading zero limbs. Empty represents zero.
+		bool negative{ false };
+	};
+
+	void trim(SignedLimbs& x) {
+		while (!x.limbs.empty() && x.limbs.back() == 0) x.limbs.pop_back();
+		if (x.limbs.empty()) x.negative = false;
+	}
+
+	SignedLimbs fromLimbs(const limb_type* a, std::size_t n) {
+		SignedLimbs result;
+		result.limbs.assign(a, a + n);
+		trim(result);
+		return result;
+	}
+
+	//x + y, or x - y if subtract is set.
+	SignedLimbs addSigned(const SignedLimbs& x, const SignedLimbs& y, bool subtract = false) {
+		const bool yNegative{ y.negative != subtract };
+		const bool xBigger{ dp::detail::compare(x.limbs.data(), x.limbs.size(), y.limbs.data(), y.limbs.size()) >= 0 };
+		const auto& bigger{ xBigger ? x.limbs : y.limbs };
+		const auto& smaller{ xBigger ? y.limbs : x.limbs };
+
+		SignedLimbs result;
+		if (x.negative == yNegative) {
+			result.limbs.resize(bigger.size() + 1);
+			result.limbs.back() = dp::detail::addUnequal(result.limbs.data(), bigger.data(), bigger.size(), smaller.data(), smaller.size());
+			result.negative = x.negative;
+		}
+		else {
+			result.limbs.resize(bigger.size());
+			dp::detail::subUnequal(result.limbs.data(), bigger.data(), bigger.size(), smaller.data(), smaller.size());
+			result.negative = xBigger ? x.negative : yNegative;
+		}
+		trim(result);
+		return result;
+	}
+
+	SignedLimbs mulSigned(const SignedLimbs& x, const SignedLimbs& y, unsigned threads = dp::detail::multiplyThreads()) {
+		SignedLimbs result;
+		if (x.limbs.empty() || y.limbs.empty()) return result;
+		result.limbs.resize(x.limbs.size() + y.limbs.size());
+		dp::detail::mul(result.limbs.data(), x.limbs.data(), x.limbs.size(), y.limbs.data(), y.limbs.size(), threads);
+		result.negative = (x.negative != y.negative);
+		trim(result);
+		return result;
+	}
+
+	//x * 2 and x / 2. The latter is only ever used where the division is known to be exact.
+	SignedLimbs doubled(SignedLimbs x) {
+		limb_type carry{ 0 };
+		for (auto& limb : x.limbs) {
+			limb_type next{ limb >> 63 };
+			limb = (limb << 1) | carry;
+			carry = next;
+		}
+		if (carry != 0) x.limbs.push_back(carry);
+		return x;
+	}
+
+	SignedLimbs halved(SignedLimbs x) {
+		for (std::size_t i = 0; i < x.limbs.size(); ++i) {
+			limb_type next{ (i + 1 < x.limbs.size()) ? x.limbs[i + 1] : 0 };
+			x.limbs[i] = (x.limbs[i] >> 1) | (next << 63);
+		}
+		trim(x);
+		return x;
+	}
+
+	//x / 3 where the division is known to be exact. Rather than dividing we multiply by the inverse of 3 modulo 2^64, carrying the
+	//high part of each quotient limb times 3 forward as a borrow into the next limb.
+	SignedLimbs thirded(SignedLimbs x) {
+		constexpr limb_type inverseOfThree{ 0xAAAAAAAAAAAAAAAB };		//3 * inverseOfThree == 1 (mod 2^64)
+		limb_type borrow{ 0 };
+		for (auto& limb : x.limbs) {
+			limb_type nextBorrow{ limb < borrow };
+			limb_type quotient{ (limb - borrow) * inverseOfThree };
+			limb_type high;
+			dp::detail::mulWide(quotient, 3, high);
+			limb = quotient;
+			borrow = high + nextBorrow;
+		}
+		trim(x);
+		return x;
+	}
+
+	//x * B^count, or x / B^count (discarding the remainder) for the downward shift.
+	SignedLimbs shiftedUp(SignedLimbs x, std::size_t count) {
+		if (!x.limbs.empty()) x.limbs.insert(x.limbs.begin(), count, 0);
+		return x;
+	}
+
+	SignedLimbs shiftedDown(SignedLimbs x, std::size_t count) {
+		x.limbs.erase(x.limbs.begin(), x.limbs.begin() + std::min(count, x.limbs.size()));
+		trim(x);
+		return x;
+	}
+
+	//B^count
+	SignedLimbs limbPower(std::size_t count) {
+		SignedLimbs result;
+		result.limbs.assign(count + 1, 0);
+		result.limbs.back() = 1;
+		return result;
+	}
+
+	//Below this many limbs, reciprocals are found by a straight long division.
+	constexpr std::size_t reciprocalThreshold{ 16 };
+
+	//Arithmetic modulo a prime p < 2^62 with the operands held in Montgomery form (x*2^64 mod p), so that modular multiplication needs no division.
+	class MontgomeryPrime {
+		limb_type m_modulus;
+		limb_type m_negativeInverse;		//-1/p (mod 2^64)
+		limb_type m_rSquared;				//2^128 (mod p)
+
+	public:
+		explicit MontgomeryPrime(limb_type modulus) : m_modulus{ modulus } {
+			//Newton's iteration for the inverse modulo 2^64. p is its own inverse modulo 2^3, and each step doubles the number of correct bits.
+			limb_type inverse{ modulus };
+			for (int i = 0; i < 5; ++i) inverse *= 2 - modulus * inverse;
+			m_negativeInverse = 0 - inverse;
+			m_rSquared = 1;
+			for (int i = 0; i < 128; ++i) m_rSquared = add(m_rSquared, m_rSquared);
+		}
+
+		//(high*2^64 + low) / 2^64 (mod p), for any input less than p*2^64.
+		limb_type reduce(limb_type low, limb_type high) const {
+			limb_type correctionHigh;
+			dp::detail::mulWide(low * m_negativeInverse, m_modulus, correctionHigh);
+			//The low halves sum to exactly 0 (mod 2^64), so they carry precisely when low is non-zero.
+			limb_type result{ high + correctionHigh + (low != 0) };
+			return (result >= m_modulus) ? result - m_modulus : result;
+		}
+
+		limb_type mul(limb_type a, limb_type b) const {
+			limb_type high;
+			limb_type low{ dp::detail::mulWide(a, b, high) };
+			return reduce(low, high);
+		}
+
+		limb_type add(limb_type a, limb_type b) const {
+			limb_type sum{ a + b };
+			return (sum >= m_modulus) ? sum - m_modulus : sum;
+		}
+
+		limb_type sub(limb_type a, limb_type b) const {
+			return (a >= b) ? a - b : a + m_modulus - b;
+		}
+
+		//Any 64-bit value can be brought into Montgomery form, not just those already reduced modulo p.
+		limb_type toMontgomery(limb_type x) const { return mul(x, m_rSquared); }
+		limb_type fromMontgomery(limb_type x) const { return reduce(x, 0); }
+
+		limb_type pow(limb_type base, limb_type exponent) const {
+			limb_type result{ toMontgomery(1) };
+			for (; exponent != 0; exponent >>= 1) {
+				if (exponent & 1) result = mul(result, base);
+				base = mul(base, base);
+			}
+			return result;
+		}
+
+		limb_type inverse(limb_type x) const { return pow(x, m_modulus - 2); }
+	};
+
+	//The three transform primes, each of the form c*2^50 + 1 so that they support transforms of up to 2^50 points, along with a primitive root of each.
+	//Their product is just under 2^186, which bounds each coefficient of the product of two n-limb numbers (< n * 2^128) for any n below 2^57.
+	struct NttPrime {
+		limb_type modulus;
+		limb_type primitiveRoot;
+	};
+	constexpr NttPrime nttPrimes[3]{
+		{ 0x3E74000000000001, 3 },
+		{ 0x3EC4000000000001, 37 },
+		{ 0x3FDC000000000001, 3 }
+	};
+
+	//The butterflies j in [begin, end) of one level of the forward transform, over a block of 2*half values whose twiddle factors are roots[j * stride].
+	//The field is taken by value so that the compiler can see that writing to values never changes it, and keep its constants in registers.
+	void forwardButterflies(limb_type* values, std::size_t half, const limb_type* roots, std::size_t stride, const MontgomeryPrime field, std::size_t begin, std::size_t end) {
+		for (std::size_t j = begin; j < end; ++j) {
+			limb_type u{ values[j] };
+			limb_type v{ values[j + half] };
+			values[j] = field.add(u, v);
+			values[j + half] = field.mul(field.sub(u, v), roots[j * stride]);
+		}
+	}
+
+	void inverseButterflies(limb_type* values, std::size_t half, const limb_type* roots, std::size_t stride, const MontgomeryPrime field, std::size_t begin, std::size_t end) {
+		for (std::size_t j = begin; j < end; ++j) {
+			limb_type u{ values[j] };
+			limb_type v{ field.mul(values[j + half], roots[j * stride]) };
+			values[j] = field.add(u, v);
+			values[j + half] = field.sub(u, v);
+		}
+	}
+
+	//In-place forward (decimation in frequency) transform of a power-of-two length sequence in Montgomery form, leaving the output in bit-reversed order.
+	//The powers of a primitive size'th root of unity are roots[0], roots[rootStride], roots[2 * rootStride], ...
+	//With threads to spare, the first level's butterflies are shared out between them, after which the two halves are independent transforms of
+	//half the size, which use every other root of this one.
+	void forwardTransform(limb_type* values, std::size_t size, const limb_type* roots, std::size_t rootStride, const MontgomeryPrime& field, unsigned threads) {
+		if (threads > 1 && size >= 4) {
+			const std::size_t half{ size / 2 };
+			parallelFor(threads, half, [=, &field](std::size_t begin, std::size_t end) {
+				forwardButterflies(values, half, roots, rootStride, field, begin, end);
+			});
+			parallelInvoke(threads,
+				[=, &field](unsigned share) { forwardTransform(values, half, roots, 2 * rootStride, field, share); },
+				[=, &field](unsigned share) { forwardTransform(values + half, half, roots, 2 * rootStride, field, share); });
+			return;
+		}
+		for (std::size_t length = size; length >= 2; length /= 2) {
+			const std::size_t half{ length / 2 };
+			const std::size_t stride{ rootStride * (size / length) };
+			for (std::size_t start = 0; start < size; start += length) {
+				forwardButterflies(values + start, half, roots, stride, field, 0, half);
+			}
+		}
+	}
+
+	//The matching inverse (decimation in time) transform, taking bit-reversed input back to natural order. roots must hold powers of the inverse root.
+	//The result is scaled up by the transform size. This runs the forward transform's levels in reverse, so when threaded the halves come first.
+	void inverseTransform(limb_type* values, std::size_t size, const limb_type* roots, std::size_t rootStride, const MontgomeryPrime& field, unsigned threads) {
+		if (threads > 1 && size >= 4) {
+			const std::size_t half{ size / 2 };
+			parallelInvoke(threads,
+				[=, &field](unsigned share) { inverseTransform(values, half, roots, 2 * rootStride, field, share); },
+				[=, &field](unsigned share) { inverseTransform(values + half, half, roots, 2 * rootStride, field, share); });
+			parallelFor(threads, half, [=, &field](std::size_t begin, std::size_t end) {
+				inverseButterflies(values, half, roots, rootStride, field, begin, end);
+			});
+			return;
+		}
+		for (std::size_t length = 2; length <= size; length *= 2) {
+			const std::size_t half{ length / 2 };
+			const std::size_t stride{ rootStride * (size / length) };
+			for (std::size_t start = 0; start < size; start += length) {
+				inverseButterflies(values + start, half, roots, stride, field, 0, half);
+			}
+		}
+	}
+
+	std::vector<limb_type> powersOf(limb_type root, std::size_t count, const MontgomeryPrime& field) {
+		std::vector<limb_type> powers(count);
+		limb_type power{ field.toMontgomery(1) };
+		for (auto& element : powers) {
+			element = power;
+			power = field.mul(power, root);
+		}
+		return powers;
+	}
+
+	//The cyclic convolution of a and b modulo one of the transform primes, as plain (non-Montgomery) residues. size must be a power of two
+	//no smaller than an + bn - 1 so that the cyclic convolution is the same as the product.
+	std::vector<limb_type> convolveModulo(const NttPrime& prime, const limb_type* a, std::size_t an, const limb_type* b, std::size_t bn, std::size_t size, unsigned threads) {
+		const MontgomeryPrime field{ prime.modulus };
+		const limb_type generator{ field.toMontgomery(prime.primitiveRoot) };
+		const limb_type root{ field.pow(generator, (prime.modulus - 1) / size) };
+		const std::vector<limb_type> roots{ powersOf(root, size / 2, field) };
+		const std::vector<limb_type> inverseRoots{ powersOf(field.inverse(root), size / 2, field) };
+
+		auto transformed = [&](std::vector<limb_type>& values, const limb_type* x, std::size_t xn, unsigned share) {
+			values.assign(size, 0);
+			parallelFor(share, xn, [&](std::size_t begin, std::size_t end) {
+				for (std::size_t i = begin; i < end; ++i) values[i] = field.toMontgomery(x[i]);
+			});
+			forwardTransform(values.data(), size, roots.data(), 1, field, share);
+		};
+
+		//Squaring needs only the one forward transform, which saves a third of the work.
+		std::vector<limb_type> aValues;
+		if (a == b && an == bn) {
+			transformed(aValues, a, an, threads);
+			parallelFor(threads, size, [&](std::size_t begin, std::size_t end) {
+				for (std::size_t i = begin; i < end; ++i) aValues[i] = field.mul(aValues[i], aValues[i]);
+			});
+		}
+		else {
+			std::vector<limb_type> bValues;
+			parallelInvoke(threads,
+				[&](unsigned share) { transformed(aValues, a, an, share); },
+				[&](unsigned share) { transformed(bValues, b, bn, share); });
+			parallelFor(threads, size, [&](std::size_t begin, std::size_t end) {
+				for (std::size_t i = begin; i < end; ++i) aValues[i] = field.mul(aValues[i], bValues[i]);
+			});
+		}
+		inverseTransform(aValues.data(), size, inverseRoots.data(), 1, field, threads);
+
+		//Multiplying by the plain (not Montgomery) value of 1/size both undoes the transform's scaling and takes the result out of Montgomery form.
+		const limb_type sizeInverse{ field.fromMontgomery(field.inverse(field.toMontgomery(size))) };
+		parallelFor(threads, size, [&](std::size_t begin, std::size_t end) {
+			for (std::size_t i = begin; i < end; ++i) aValues[i] = field.mul(aValues[i], sizeInverse);
+		});
+		return aValues;
+	}
+}
+
+//Vector registers for the bitwise routines. Which instructions we have is fixed at compile time by the target architecture flags.
+namespace {
+
+	enum class BitwiseOp { And, Or, Xor };
+
+	template<BitwiseOp Op>
+	limb_type applyLimbs(limb_type x, limb_type y) {
+		if constexpr (Op == BitwiseOp::And) return x & y;
+		else if constexpr (Op == BitwiseOp::Or) return x | y;
+		else return x ^ y;
+	}
+
+#if defined(__AVX512F__)
+#define DP_BIGINT_VECTOR_LIMBS 8
+	using Vector = __m512i;
+	inline Vector loadVector(const limb_type* p) { return _mm512_loadu_si512(p); }
+	inline void storeVector(limb_type* p, Vector v) { _mm512_storeu_si512(p, v); }
+	inline Vector allOnes() { return _mm512_set1_epi64(-1); }
+	inline bool isZero(Vector v) { return _mm512_test_epi64_mask(v, v) == 0; }
+
+	template<BitwiseOp Op>
+	Vector applyVectors(Vector x, Vector y) {
+		if constexpr (Op == BitwiseOp::And) return _mm512_and_si512(x, y);
+		else if constexpr (Op == BitwiseOp::Or) return _mm512_or_si512(x, y);
+		else return _mm512_xor_si512(x, y);
+	}
+#elif defined(__AVX2__)
+#define DP_BIGINT_VECTOR_LIMBS 4
+	using Vector = __m256i;
+	inline Vector loadVector(const limb_type* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+	inline void storeVector(limb_type* p, Vector v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+	inline Vector allOnes() { return _mm256_set1_epi64x(-1); }
+	inline bool isZero(Vector v) { return _mm256_testz_si256(v, v) != 0; }
+
+	template<BitwiseOp Op>
+	Vector applyVectors(Vector x, Vector y) {
+		if constexpr (Op == BitwiseOp::And) return _mm256_and_si256(x, y);
+		else if constexpr (Op == BitwiseOp::Or) return _mm256_or_si256(x, y);
+		else return _mm256_xor_si256(x, y);
+	}
+#endif
+
+	template<BitwiseOp Op>
+	void combineLimbs(limb_type* out, const limb_type* a, const limb_type* b, std::size_t n) {
+		std::size_t i{ 0 };
+#if defined(DP_BIGINT_VECTOR_LIMBS)
+		for (; i + DP_BIGINT_VECTOR_LIMBS <= n; i += DP_BIGINT_VECTOR_LIMBS) {
+			storeVector(out + i, applyVectors<Op>(loadVector(a + i), loadVector(b + i)));
+		}
+#endif
+		for (; i < n; ++i) out[i] = applyLimbs<Op>(a[i], b[i]);
+	}
+
+#if defined(__AVX2__)
+	//The population counts of each byte of v, summed into its four 64-bit lanes. Each nibble's count comes from a table lookup with a byte shuffle,
+	//and the bytes are summed by taking their absolute difference from zero. This is the method of Mula, Kurz and Lemire.
+	inline __m256i popcountLanes(__m256i v) {
+		const __m256i table{ _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4) };
+		const __m256i lowNibbles{ _mm256_set1_epi8(0x0F) };
+		const __m256i counts{ _mm256_add_epi8(_mm256_shuffle_epi8(table, _mm256_and_si256(v, lowNibbles)),
+			_mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), lowNibbles))) };
+		return _mm256_sad_epu8(counts, _mm256_setzero_si256());
+	}
+#endif
+}
+
+//Helpers for the GCD routines.
+namespace {
+
+	//The length of x[0..n) once any leading zero limbs are dropped, which is 0 for zero itself.
+	std::size_t trimmedSize(const limb_type* x, std::size_t n) {
+		while (n > 0 && x[n - 1] == 0) --n;
+		return n;
+	}
+
+	//The leading 62 bits of x, taken from the same bit positions that the leading 62 bits of a value of n limbs with top limb x[n-1] would be.
+	//Keeping two bits spare means that Lehmer's single-precision values and cofactors can be added without overflowing a signed 64-bit integer.
+	std::int64_t leadingBits(const limb_type* x, std::size_t n, unsigned shift) {
+		limb_type top{ x[n - 1] << shift };
+		if (shift != 0 && n >= 2) top |= x[n - 2] >> (64 - shift);
+		return static_cast<std::int64_t>(top >> 2);
+	}
+
+	//out[0..n] = p*x + q*y, where p and q are of opposite signs (or one is zero) and the result is known to be non-negative.
+	void combine(limb_type* out, const limb_type* x, const limb_type* y, std::size_t n, std::int64_t p, std::int64_t q) {
+		if (q > 0) {
+			std::swap(x, y);
+			std::swap(p, q);
+		}
+		out[n] = dp::detail::mulSingle(out, x, n, static_cast<limb_type>(p));
+		out[n] -= dp::detail::subMulSingle(out, y, n, static_cast<limb_type>(-q));
+	}
+
+	//Shifts the two-limb value (high, low) right by shift < 128 bits.
+	void shiftRightTwoLimbs(limb_type& high, limb_type& low, unsigned shift) {
+		if (shift >= 64) {
+			low = high >> (shift - 64);
+			high = 0;
+		}
+		else if (shift != 0) {
+			low = (low >> shift) | (high << (64 - shift));
+			high >>= shift;
+		}
+	}
+
+	unsigned trailingZerosTwoLimbs(limb_type high, limb_type low) {
+		return low != 0 ? dp::detail::countTrailingZeros(low) : 64 + dp::detail::countTrailingZeros(high);
+	}
+
+	//Binary GCD of two non-zero values of up to two limbs each, which is written over (uHigh, uLow). Every subtraction of one odd value from another
+	//leaves an even one, so each step clears at least one bit, and all of the trailing zeroes are stripped at once with a count and a shift.
+	void gcdTwoLimbs(limb_type& uHigh, limb_type& uLow, limb_type vHigh, limb_type vLow) {
+		const unsigned uZeros{ trailingZerosTwoLimbs(uHigh, uLow) };
+		const unsigned vZeros{ trailingZerosTwoLimbs(vHigh, vLow) };
+		const unsigned commonZeros{ std::min(uZeros, vZeros) };
+		shiftRightTwoLimbs(uHigh, uLow, uZeros);
+		shiftRightTwoLimbs(vHigh, vLow, vZeros);
+
+		//Once both values fit in a single limb there is no need to carry the high halves around.
+		while (uHigh != 0 || vHigh != 0) {
+			if (uHigh > vHigh || (uHigh == vHigh && uLow > vLow)) {
+				std::swap(uHigh, vHigh);
+				std::swap(uLow, vLow);
+			}
+			dp::detail::subBorrow(dp::detail::subBorrow(0, vLow, uLow, vLow), vHigh, uHigh, vHigh);
+			if (vHigh == 0 && vLow == 0) break;
+			shiftRightTwoLimbs(vHigh, vLow, trailingZerosTwoLimbs(vHigh, vLow));
+		}
+		if (uHigh == 0 && vHigh == 0 && vLow != 0) {
+			while (uLow != vLow) {
+				if (uLow > vLow) std::swap(uLow, vLow);
+				vLow -= uLow;
+				vLow >>= dp::detail::countTrailingZeros(vLow);
+			}
+		}
+
+		//Restore the power of two common to both.
+		if (commonZeros >= 64) {
+			uHigh = uLow << (commonZeros - 64);
+			uLow = 0;
+		}
+		else if (commonZeros != 0) {
+			uHigh = (uHigh << commonZeros) | (uLow >> (64 - commonZeros));
+			uLow <<= commonZeros;
+		}
+	}
+}
+
+namespace dp {
+	namespace detail {
+
+		/*
+		* ADDITION AND SUBTRACTION
+		*/
+		limb_type addSame(limb_type* out, const limb_type* a, const limb_type* b, std::size_t n) {
+			unsigned char carry{ 0 };
+			for (std::size_t i = 0; i < n; ++i) {
+				carry = addCarry(carry, a[i], b[i], out[i]);
+			}
+			return carry;
+		}
+
+		limb_type addUnequal(limb_type* out, const limb_type* a, std::size_t an, const limb_type* b, std::size_t bn) {
+			limb_type carry{ addSame(out, a, b, bn) };
+			return addSingle(out + bn, a + bn, an - bn, carry);
+		}
+
+		limb_type addSingle(limb_type* out, const limb_type* a, std::size_t n, limb_type b) {
+			std::size_t i{ 0 };
+			//Once the carry dies out, the remaining limbs are a straight copy.
+			for (; i < n && b != 0; ++i) {
+				out[i] = a[i] + b;
+				b = (out[i] < b);
+			}
+			if (out != a) std::copy(a + i, a + n, out + i);
+			return b;
+		}
+
+		limb_type subSame(limb_type* out, const limb_type* a, const limb_type* b, std::size_t n) {
+			unsigned char borrow{ 0 };
+			for (std::size_t i = 0; i < n; ++i) {
+				borrow = subBorrow(borrow, a[i], b[i], out[i]);
+			}
+			return borrow;
+		}
+
+		limb_type subUnequal(limb_type* out, const limb_type* a, std::size_t an, const limb_type* b, std::size_t bn) {
+			limb_type borrow{ subSame(out, a, b, bn) };
+			return subSingle(out + bn, a + bn, an - bn, borrow);
+		}
+
+		limb_type subSingle(limb_type* out, const limb_type* a, std::size_t n, limb_type b) {
+			std::size_t i{ 0 };
+			for (; i < n && b != 0; ++i) {
+				limb_type x{ a[i] };
+				out[i] = x - b;
+				b = (x < b);
+			}
+			if (out != a) std::copy(a + i, a + n, out + i);
+			return b;
+		}
+
+		int compare(const limb_type* a, std::size_t an, const limb_type* b, std::size_t bn) {
+			for (; an > bn; --an) {
+				if (a[an - 1] != 0) return 1;
+			}
+			for (; bn > an; --bn) {
+				if (b[bn - 1] != 0) return -1;
+			}
+			for (std::size_t i = an; i-- > 0;) {
+				if (a[i] != b[i]) return (a[i] < b[i]) ? -1 : 1;
+			}
+			return 0;
+		}
+
+		/*
+		* SHIFTS
+		*/
+		limb_type shiftLeftBits(limb_type* out, const limb_type* a, std::size_t n, unsigned shift) {
+			//Work from the top down so that out may alias a.
+			const unsigned backShift{ 64 - shift };
+			const limb_type shiftedOut{ a[n - 1] >> backShift };
+			for (std::size_t i = n - 1; i > 0; --i) {
+				out[i] = (a[i] << shift) | (a[i - 1] >> backShift);
+			}
+			out[0] = a[0] << shift;
+			return shiftedOut;
+		}
+
+		limb_type shiftRightBits(limb_type* out, const limb_type* a, std::size_t n, unsigned shift) {
+			const unsigned backShift{ 64 - shift };
+			const limb_type shiftedOut{ a[0] << backShift };
+			for (std::size_t i = 0; i + 1 < n; ++i) {
+				out[i] = (a[i] >> shift) | (a[i + 1] << backShift);
+			}
+			out[n - 1] = a[n - 1] >> shift;
+			return shiftedOut;
+		}
+
+		/*
+		* BITWISE OPERATIONS
+		*/
+		void andSame(limb_type* out, const limb_type* a, const limb_type* b, std::size_t n) {
+			combineLimbs<BitwiseOp::And>(out, a, b, n);
+		}
+
+		void orSame(limb_type* out, const limb_type* a, const limb_type* b, std::size_t n) {
+			combineLimbs<BitwiseOp::Or>(out, a, b, n);
+		}
+
+		void xorSame(limb_type* out, const limb_type* a, const limb_type* b, std::size_t n) {
+			combineLimbs<BitwiseOp::Xor>(out, a, b, n);
+		}
+
+		void complement(limb_type* out, const limb_type* a, std::size_t n) {
+			std::size_t i{ 0 };
+#if defined(DP_BIGINT_VECTOR_LIMBS)
+			const Vector ones{ allOnes() };
+			for (; i + DP_BIGINT_VECTOR_LIMBS <= n; i += DP_BIGINT_VECTOR_LIMBS) {
+				storeVector(out + i, applyVectors<BitwiseOp::Xor>(loadVector(a + i), ones));
+			}
+#endif
+			for (; i < n; ++i) out[i] = ~a[i];
+		}
+
+		std::size_t popcount(const limb_type* a, std::size_t n) {
+			std::size_t count{ 0 };
+			std::size_t i{ 0 };
+#if defined(__AVX512VPOPCNTDQ__)
+			__m512i lanes{ _mm512_setzero_si512() };
+			for (; i + 8 <= n; i += 8) {
+				lanes = _mm512_add_epi64(lanes, _mm512_popcnt_epi64(_mm512_loadu_si512(a + i)));
+			}
+			count = static_cast<std::size_t>(_mm512_reduce_add_epi64(lanes));
+#elif defined(__AVX2__)
+			__m256i lanes{ _mm256_setzero_si256() };
+			for (; i + 4 <= n; i += 4) {
+				lanes = _mm256_add_epi64(lanes, popcountLanes(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i))));
+			}
+			alignas(32) limb_type sums[4];
+			_mm256_store_si256(reinterpret_cast<__m256i*>(sums), lanes);
+			count = static_cast<std::size_t>(sums[0] + sums[1] + sums[2] + sums[3]);
+#endif
+			for (; i < n; ++i) count += static_cast<std::size_t>(popcount(a[i]));
+			return count;
+		}
+
+		std::size_t countTrailingZeros(const limb_type* a, std::size_t n) {
+			std::size_t i{ 0 };
+#if defined(DP_BIGINT_VECTOR_LIMBS)
+			while (i + DP_BIGINT_VECTOR_LIMBS <= n && isZero(loadVector(a + i))) i += DP_BIGINT_VECTOR_LIMBS;
+#endif
+			while (i < n && a[i] == 0) ++i;
+			if (i == n) return 64 * n;
+			return 64 * i + static_cast<std::size_t>(countTrailingZeros(a[i]));
+		}
+
+		std::size_t countLeadingZeros(const limb_type* a, std::size_t n) {
+			std::size_t i{ n };
+#if defined(DP_BIGINT_VECTOR_LIMBS)
+			while (i >= DP_BIGINT_VECTOR_LIMBS && isZero(loadVector(a + i - DP_BIGINT_VECTOR_LIMBS))) i -= DP_BIGINT_VECTOR_LIMBS;
+#endif
+			while (i > 0 && a[i - 1] == 0) --i;
+			if (i == 0) return 64 * n;
+			return 64 * (n - i) + static_cast<std::size_t>(countLeadingZeros(a[i - 1]));
+		}
+
+		/*
+		* MULTIPLICATION
+		*/
+		limb_type mulSingle(limb_type* out, const limb_type* a, std::size_t n, limb_type b) {
+			limb_type carry{ 0 };
+			for (std::size_t i = 0; i < n; ++i) {
+				limb_type high;
+				limb_type low{ mulWide(a[i], b, high) };
+				low += carry;
+				carry = high + (low < carry);			//high <= 2^64 - 2, so this can never overflow.
+				out[i] = low;
+			}
+			return carry;
+		}
+
+		limb_type addMulSingle(limb_type* out, const limb_type* a, std::size_t n, limb_type b) {
+			limb_type carry{ 0 };
+			for (std::size_t i = 0; i < n; ++i) {
+				limb_type high;
+				limb_type low{ mulWide(a[i], b, high) };
+				low += carry;
+				high += (low < carry);
+				low += out[i];
+				high += (low < out[i]);					//a*b + carry + out[i] <= 2^128 - 1, so the high limb still cannot overflow.
+				out[i] = low;
+				carry = high;
+			}
+			return carry;
+		}
+
+		limb_type subMulSingle(limb_type* out, const limb_type* a, std::size_t n, limb_type b) {
+			limb_type borrow{ 0 };
+			for (std::size_t i = 0; i < n; ++i) {
+				limb_type high;
+				limb_type low{ mulWide(a[i], b, high) };
+				low += borrow;
+				high += (low < borrow);
+				limb_type x{ out[i] };
+				out[i] = x - low;
+				borrow = high + (x < low);
+			}
+			return borrow;
+		}
+
+		void mulSchoolbook(limb_type* out, const limb_type* a, std::size_t an, const limb_type* b, std::size_t bn) {
+			//Keep the longer operand in the inner loop so that each pass over it does as much work as possible.
+			if (an < bn) {
+				std::swap(a, b);
+				std::swap(an, bn);
+			}
+			//The first row initialises the output, every subsequent row accumulates into it shifted along by one limb.
+			out[an] = mulSingle(out, a, an, b[0]);
+			for (std::size_t i = 1; i < bn; ++i) {
+				out[an + i] = addMulSingle(out + i, a, an, b[i]);
+			}
+		}
+
+		void mulKaratsuba(limb_type* out, const limb_type* a, const limb_type* b, std::size_t n, unsigned threads) {
+			assert(n >= karatsubaMinimumSize);
+			//Split each operand into a low and a high half, a = a0 + a1 * B^low, with the high half being no longer than the low half.
+			//Then a*b = z0 + (z0 + z2 - (a0 - a1)(b0 - b1)) * B^low + z2 * B^(2*low), where z0 = a0*b0 and z2 = a1*b1, for three half-sized products rather than four.
+			//Using the differences rather than the sums of the halves keeps every intermediate within low limbs, at the cost of tracking their signs.
+			//When squaring, a and b are the same array and so are their differences, which makes all three products squares and the middle sign positive.
+			const std::size_t low{ (n + 1) / 2 };
+			const std::size_t high{ n - low };
+			const bool squaring{ a == b };
+
+			std::vector<limb_type> scratch(6 * low + 1);
+			limb_type* aDifference{ scratch.data() };
+			limb_type* bDifference{ squaring ? aDifference : aDifference + low };
+			limb_type* differenceProduct{ aDifference + 2 * low };
+			limb_type* middle{ differenceProduct + 2 * low };
+
+			const bool aNegative{ absDifference(aDifference, a, low, a + low, high) };
+			const bool bNegative{ squaring ? aNegative : absDifference(bDifference, b, low, b + low, high) };
+
+			parallelInvoke(threads,
+				[=](unsigned share) { mul(out, a, low, b, low, share); },
+				[=](unsigned share) { mul(out + 2 * low, a + low, high, b + low, high, share); },
+				[=](unsigned share) { mul(differenceProduct, aDifference, low, bDifference, low, share); });
+
+			middle[2 * low] = addUnequal(middle, out, 2 * low, out + 2 * low, 2 * high);
+			if (aNegative == bNegative) {
+				middle[2 * low] -= subSame(middle, middle, differenceProduct, 2 * low);
+			}
+			else {
+				middle[2 * low] += addSame(middle, middle, differenceProduct, 2 * low);
+			}
+			//The final sum fits in 2n limbs, so adding the middle term cannot carry out of the top.
+			addUnequal(out + low, out + low, 2 * n - low, middle, 2 * low + 1);
+		}
+
+		void mulToom3(limb_type* out, const limb_type* a, const limb_type* b, std::size_t n, unsigned threads) {
+			assert(n >= toom3MinimumSize);
+			//Split each operand into thirds, a = a0 + a1*x + a2*x^2 where x = B^third, evaluate both polynomials at the points 0, 1, -1, -2 and infinity,
+			//multiply pointwise (five products of a third of the size rather than nine), and interpolate the coefficients of the product polynomial back out.
+			//The evaluation and interpolation sequences are those of Bodrato and Zanoni.
+			const std::size_t third{ (n + 2) / 3 };
+			const std::size_t top{ n - 2 * third };
+
+			auto evaluate = [third, top](const limb_type* x, SignedLimbs& atOne, SignedLimbs& atMinusOne, SignedLimbs& atMinusTwo) {
+				SignedLimbs x0{ fromLimbs(x, third) };
+				SignedLimbs x1{ fromLimbs(x + third, third) };
+				SignedLimbs x2{ fromLimbs(x + 2 * third, top) };
+				SignedLimbs outer{ addSigned(x0, x2) };
+				atOne = addSigned(outer, x1);
+				atMinusOne = addSigned(outer, x1, true);
+				atMinusTwo = addSigned(doubled(addSigned(atMinusOne, x2)), x0, true);
+			};
+
+			//When squaring, b's evaluations are a's. Passing the same values to both sides of each product then makes those products squares too.
+			const bool squaring{ a == b };
+			SignedLimbs aAtOne, aAtMinusOne, aAtMinusTwo;
+			SignedLimbs bValues[3];
+			evaluate(a, aAtOne, aAtMinusOne, aAtMinusTwo);
+			if (!squaring) evaluate(b, bValues[0], bValues[1], bValues[2]);
+			const SignedLimbs& bAtOne{ squaring ? aAtOne : bValues[0] };
+			const SignedLimbs& bAtMinusOne{ squaring ? aAtMinusOne : bValues[1] };
+			const SignedLimbs& bAtMinusTwo{ squaring ? aAtMinusTwo : bValues[2] };
+
+			//The products at 0 and infinity go straight into their final place in the output.
+			std::fill(out + 2 * third, out + 4 * third, 0);
+			SignedLimbs r1, rMinusOne, r3;
+			parallelInvoke(threads,
+				[=](unsigned share) { mul(out, a, third, b, third, share); },
+				[=](unsigned share) { mul(out + 4 * third, a + 2 * third, top, b + 2 * third, top, share); },
+				[&](unsigned share) { r1 = mulSigned(aAtOne, bAtOne, share); },
+				[&](unsigned share) { rMinusOne = mulSigned(aAtMinusOne, bAtMinusOne, share); },
+				[&](unsigned share) { r3 = mulSigned(aAtMinusTwo, bAtMinusTwo, share); });
+			const SignedLimbs r0{ fromLimbs(out, 2 * third) };
+			const SignedLimbs rInfinity{ fromLimbs(out + 4 * third, 2 * top) };
+
+			r3 = thirded(addSigned(r3, r1, true));
+			r1 = halved(addSigned(r1, rMinusOne, true));
+			SignedLimbs r2{ addSigned(rMinusOne, r0, true) };
+			r3 = addSigned(halved(addSigned(r2, r3, true)), doubled(rInfinity));
+			r2 = addSigned(addSigned(r2, r1), rInfinity, true);
+			r1 = addSigned(r1, r3, true);
+
+			//All three remaining coefficients are non-negative, and the total fits in 2n limbs, so none of these additions can carry out of the top.
+			const SignedLimbs* coefficients[]{ &r1, &r2, &r3 };
+			for (std::size_t i = 0; i < 3; ++i) {
+				const auto& limbs{ coefficients[i]->limbs };
+				const std::size_t offset{ (i + 1) * third };
+				addUnequal(out + offset, out + offset, 2 * n - offset, limbs.data(), limbs.size());
+			}
+		}
+
+		void mulNtt(limb_type* out, const limb_type* a, std::size_t an, const limb_type* b, std::size_t bn, unsigned threads) {
+			const std::size_t coefficients{ an + bn - 1 };
+			std::size_t size{ 1 };
+			while (size < coefficients) size *= 2;
+
+			std::vector<limb_type> residues0, residues1, residues2;
+			parallelInvoke(threads,
+				[&](unsigned share) { residues0 = convolveModulo(nttPrimes[0], a, an, b, bn, size, share); },
+				[&](unsigned share) { residues1 = convolveModulo(nttPrimes[1], a, an, b, bn, size, share); },
+				[&](unsigned share) { residues2 = convolveModulo(nttPrimes[2], a, an, b, bn, size, share); });
+
+			//Garner's algorithm recovers each coefficient x < p0*p1*p2 from its residues as x = x0 + x1*p0 + x2*p0*p1, with each xi < pi.
+			//As p0 < p1 < p2, a residue modulo a smaller prime is already reduced modulo the larger ones.
+			const limb_type p0{ nttPrimes[0].modulus };
+			const limb_type p1{ nttPrimes[1].modulus };
+			const MontgomeryPrime field1{ p1 };
+			const MontgomeryPrime field2{ nttPrimes[2].modulus };
+			const limb_type p0InverseModulo1{ field1.inverse(field1.toMontgomery(p0)) };
+			const limb_type p0Modulo2{ field2.toMontgomery(p0) };
+			const limb_type p0p1InverseModulo2{ field2.inverse(field2.mul(p0Modulo2, field2.toMontgomery(p1))) };
+			limb_type p0p1[2];
+			p0p1[0] = mulWide(p0, p1, p0p1[1]);
+
+			//Each coefficient overlaps the next two limbs up, so we carry a three-limb running total along the output. When threaded, each thread
+			//takes its own run of coefficients and running total, and what is left of each total is added in above its run once they are all done.
+			const std::size_t pieces{ std::min<std::size_t>(std::max(threads, 1u), coefficients) };
+			std::vector<std::array<limb_type, 2>> remainders(pieces);
+			auto recombine = [&](std::size_t piece) {
+				limb_type carry[3]{ 0, 0, 0 };
+				for (std::size_t i = coefficients * piece / pieces; i < coefficients * (piece + 1) / pieces; ++i) {
+					//Multiplying a plain value by a Montgomery form constant gives a plain result.
+					const limb_type x0{ residues0[i] };
+					const limb_type x1{ field1.mul(field1.sub(residues1[i], x0), p0InverseModulo1) };
+					const limb_type x2{ field2.mul(field2.sub(field2.sub(residues2[i], x0), field2.mul(x1, p0Modulo2)), p0p1InverseModulo2) };
+
+					limb_type term[3];
+					term[0] = mulWide(x1, p0, term[1]);
+					term[2] = 0;
+					addSingle(term, term, 3, x0);
+					addSame(carry, carry, term, 3);
+					term[2] = mulSingle(term, p0p1, 2, x2);
+					addSame(carry, carry, term, 3);
+
+					out[i] = carry[0];
+					carry[0] = carry[1];
+					carry[1] = carry[2];
+					carry[2] = 0;
+				}
+				remainders[piece] = { carry[0], carry[1] };
+			};
+			parallelFor(threads, pieces, [&](std::size_t begin, std::size_t end) {
+				for (std::size_t piece = begin; piece < end; ++piece) recombine(piece);
+			});
+
+			//The product fits in an + bn limbs, so the last remainder is a single limb, and no addition carries out of the top.
+			out[coefficients] = remainders.back()[0];
+			for (std::size_t piece = 0; piece + 1 < pieces; ++piece) {
+				const std::size_t end{ coefficients * (piece + 1) / pieces };
+				addUnequal(out + end, out + end, coefficients + 1 - end, remainders[piece].data(), 2);
+			}
+		}
+
+		void setMultiplyThreads(unsigned count) {
+			if (count == 0) count = std::max(std::thread::hardware_concurrency(), 1u);
+			multiplyThreadCount.store(count, std::memory_order_relaxed);
+		}
+
+		unsigned multiplyThreads() {
+			return multiplyThreadCount.load(std::memory_order_relaxed);
+		}
+
+		void mul(limb_type* out, const limb_type* a, std::size_t an, const limb_type* b, std::size_t bn) {
+			mul(out, a, an, b, bn, multiplyThreads());
+		}
+
+		void mul(limb_type* out, const limb_type* a, std::size_t an, const limb_type* b, std::size_t bn, unsigned threads) {
+			if (an < bn) {
+				std::swap(a, b);
+				std::swap(an, bn);
+			}
+			if (bn < parallelThreshold) threads = 1;
+			if (bn < karatsubaThreshold) {
+				if (a == b && an == bn) sqrSchoolbook(out, a, an);
+				else mulSchoolbook(out, a, an, b, bn);
+				return;
+			}
+			if (bn >= nttThreshold) {
+				mulNtt(out, a, an, b, bn, threads);
+				return;
+			}
+			if (an == bn) {
+				if (bn < toom3Threshold) mulKaratsuba(out, a, b, bn, threads);
+				else mulToom3(out, a, b, bn, threads);
+				return;
+			}
+
+			//For unbalanced operands we cut the longer one into chunks the size of the shorter, so that each chunk can be a balanced product,
+			//and add each partial product into place. Each partial overlaps the previous one by bn limbs.
+			const std::size_t chunks{ (an + bn - 1) / bn };
+			if (threads > 1 && chunks > 1) {
+				//Given threads, the chunks are dealt out in runs, one run to each thread. The first run goes straight into the output, and the rest into
+				//buffers of their own which are added into place afterwards, from the bottom up so that each overlaps a part of the output already written.
+				const unsigned runs{ chunks < threads ? static_cast<unsigned>(chunks) : threads };
+				std::vector<std::vector<limb_type>> partials(runs);
+				auto runStart = [=](std::size_t run) { return std::min(an, bn * (chunks * run / runs)); };
+				parallelFor(runs, runs, [&](std::size_t begin, std::size_t end) {
+					for (std::size_t run = begin; run < end; ++run) {
+						const std::size_t length{ runStart(run + 1) - runStart(run) };
+						limb_type* destination{ out };
+						if (run != 0) {
+							partials[run].resize(length + bn);
+							destination = partials[run].data();
+						}
+						mul(destination, a + runStart(run), length, b, bn, threads / static_cast<unsigned>(runs));
+					}
+				});
+				for (std::size_t run = 1; run < runs; ++run) {
+					const std::size_t offset{ runStart(run) };
+					const std::size_t length{ runStart(run + 1) - offset };
+					const limb_type* partial{ partials[run].data() };
+					limb_type carry{ addSame(out + offset, out + offset, partial, bn) };
+					addSingle(out + offset + bn, partial + bn, length, carry);
+				}
+				return;
+			}
+			mul(out, a, bn, b, bn, 1);
+			std::vector<limb_type> partial(2 * bn);
+			for (std::size_t offset = bn; offset < an; offset += bn) {
+				const std::size_t chunk{ std::min(bn, an - offset) };
+				mul(partial.data(), a + offset, chunk, b, bn, 1);
+				limb_type carry{ addSame(out + offset, out + offset, partial.data(), bn) };
+				addSingle(out + offset + bn, partial.data() + bn, chunk, carry);
+			}
+		}
+
+		void sqrSchoolbook(limb_type* out, const limb_type* a, std::size_t n) {
+			//Sum the cross products a[i]*a[j] for i < j, one row per i, with each row's carry landing on a limb no earlier row has reached.
+			std::fill(out, out + 2 * n, 0);
+			for (std::size_t i = 0; i + 1 < n; ++i) {
+				out[i + n] = addMulSingle(out + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+			}
+			//Every cross product appears twice in the square, so double them all, then add in the squares of each limb along the diagonal.
+			shiftLeftBits(out, out, 2 * n, 1);
+			unsigned char carry{ 0 };
+			for (std::size_t i = 0; i < n; ++i) {
+				limb_type high;
+				const limb_type low{ mulWide(a[i], a[i], high) };
+				carry = addCarry(carry, out[2 * i], low, out[2 * i]);
+				carry = addCarry(carry, out[2 * i + 1], high, out[2 * i + 1]);
+			}
+		}
+
+		void sqr(limb_type* out, const limb_type* a, std::size_t n) {
+			mul(out, a, n, a, n);
+		}
+
+		/*
+		* DIVISION
+		*/
+		limb_type divRemSingle(limb_type* quotient, const limb_type* a, std::size_t n, limb_type b) {
+			limb_type remainder{ 0 };
+			for (std::size_t i = n; i-- > 0;) {
+				limb_type digit{ divWide(remainder, a[i], b, remainder) };
+				if (quotient) quotient[i] = digit;
+			}
+			return remainder;
+		}
+
+		limb_type divRemPreinverted(limb_type* quotient, const limb_type* a, std::size_t n, limb_type normalised, limb_type reciprocal, unsigned shift) {
+			//We divide (a << shift) by the normalised divisor, which gives the same quotient and a remainder shifted up by the same amount.
+			//The shift is applied on the fly as each limb is read, so a is never copied.
+			const unsigned backShift{ 64 - shift };
+			limb_type remainder{ (shift == 0) ? 0 : a[n - 1] >> backShift };
+			for (std::size_t i = n; i-- > 0;) {
+				limb_type low{ a[i] << shift };
+				if (shift != 0 && i > 0) low |= a[i - 1] >> backShift;
+
+				//Moller and Granlund's 2-by-1 division: estimate the quotient digit from the reciprocal, then correct it at most twice.
+				limb_type estimateHigh;
+				limb_type estimateLow{ mulWide(reciprocal, remainder, estimateHigh) };
+				estimateLow += low;
+				estimateHigh += remainder + 1 + (estimateLow < low);
+				limb_type digitRemainder{ low - estimateHigh * normalised };
+				if (digitRemainder > estimateLow) {
+					--estimateHigh;
+					digitRemainder += normalised;
+				}
+				if (digitRemainder >= normalised) {
+					++estimateHigh;
+					digitRemainder -= normalised;
+				}
+				if (quotient) quotient[i] = estimateHigh;
+				remainder = digitRemainder;
+			}
+			return remainder >> shift;
+		}
+
+		void divRem(limb_type* quotient, limb_type* remainder, const limb_type* a, std::size_t an, const limb_type* b, std::size_t bn) {
+			if (bn == 1) {
+				limb_type singleRemainder{ divRemSingle(quotient, a, an, b[0]) };
+				if (remainder) remainder[0] = singleRemainder;
+				return;
+			}
+
+			//Normalise so that the top bit of the divisor is set, which guarantees that each estimated quotient digit is at most two too large.
+			//The normalised dividend doubles as the running remainder, and shares a single scratch buffer with the normalised divisor.
+			const unsigned shift{ static_cast<unsigned>(countLeadingZeros(b[bn - 1])) };
+			std::vector<limb_type> scratch(an + 1 + bn);
+			limb_type* u{ scratch.data() };
+			limb_type* v{ u + an + 1 };
+			if (shift == 0) {
+				std::copy(a, a + an, u);
+				u[an] = 0;
+				std::copy(b, b + bn, v);
+			}
+			else {
+				u[an] = shiftLeftBits(u, a, an, shift);
+				shiftLeftBits(v, b, bn, shift);
+			}
+
+			const limb_type divisorTop{ v[bn - 1] };
+			const limb_type divisorNext{ v[bn - 2] };
+			for (std::size_t j = an - bn + 1; j-- > 0;) {
+				//Estimate the quotient digit from the top two limbs of the remainder and top limb of the divisor, then refine it with the next divisor limb.
+				limb_type estimate;
+				limb_type estimateRemainder;
+				bool remainderOverflowed{ false };
+				if (u[j + bn] >= divisorTop) {
+					//The top remainder limb can never exceed the divisor's, but if they are equal the true digit is B-1 or B-2, and the 128/64 division would overflow.
+					estimate = ~static_cast<limb_type>(0);
+					estimateRemainder = u[j + bn - 1] + divisorTop;
+					remainderOverflowed = (estimateRemainder < divisorTop);
+				}
+				else {
+					estimate = divWide(u[j + bn], u[j + bn - 1], divisorTop, estimateRemainder);
+				}
+				while (!remainderOverflowed) {
+					limb_type productHigh;
+					limb_type productLow{ mulWide(estimate, divisorNext, productHigh) };
+					if (productHigh < estimateRemainder || (productHigh == estimateRemainder && productLow <= u[j + bn - 2])) break;
+					--estimate;
+					estimateRemainder += divisorTop;
+					remainderOverflowed = (estimateRemainder < divisorTop);
+				}
+
+				//Subtract estimate * divisor from the remainder. In the rare case the estimate was still one too large this goes negative, and we add the divisor back.
+				const limb_type borrow{ subMulSingle(u + j, v, bn, estimate) };
+				const limb_type top{ u[j + bn] };
+				u[j + bn] = top - borrow;
+				if (top < borrow) {
+					--estimate;
+					u[j + bn] += addSame(u + j, u + j, v, bn);
+				}
+				if (quotient) quotient[j] = estimate;
+			}
+
+			if (remainder) {
+				if (shift == 0) std::copy(u, u + bn, remainder);
+				else shiftRightBits(remainder, u, bn, shift);
+			}
+		}
+
+
+		std::vector<limb_type> reciprocal(const limb_type* d, std::size_t n) {
+			if (n < reciprocalThreshold) {
+				SignedLimbs numerator{ limbPower(2 * n) };
+				std::vector<limb_type> result(n + 2);
+				divRem(result.data(), nullptr, numerator.limbs.data(), numerator.limbs.size(), d, n);
+				return result;
+			}
+
+			//Find the reciprocal of the top half (plus two guard limbs) of d, which scaled up by the limbs we dropped is correct to roughly half the
+			//limbs we need. One Newton step, r' = r + r(B^2n - dr) / B^2n, then doubles the number of correct limbs, leaving an error of a few units at most.
+			const std::size_t topLimbs{ n / 2 + 2 };
+			const std::size_t droppedLimbs{ n - topLimbs };
+			const std::vector<limb_type> topReciprocal{ reciprocal(d + droppedLimbs, topLimbs) };
+			const SignedLimbs divisor{ fromLimbs(d, n) };
+			const SignedLimbs target{ limbPower(2 * n) };
+
+			SignedLimbs estimate{ shiftedUp(fromLimbs(topReciprocal.data(), topReciprocal.size()), droppedLimbs) };
+			const SignedLimbs error{ addSigned(target, mulSigned(divisor, estimate), true) };
+			estimate = addSigned(estimate, shiftedDown(mulSigned(estimate, error), 2 * n));
+
+			//Then fix up the last few units so the result is exactly the floor, i.e. 0 <= B^2n - d*r < d.
+			SignedLimbs remainder{ addSigned(target, mulSigned(divisor, estimate), true) };
+			const SignedLimbs one{ limbPower(0) };
+			while (remainder.negative) {
+				estimate = addSigned(estimate, one, true);
+				remainder = addSigned(remainder, divisor);
+			}
+			while (dp::detail::compare(remainder.limbs.data(), remainder.limbs.size(), d, n) >= 0) {
+				estimate = addSigned(estimate, one);
+				remainder = addSigned(remainder, divisor, true);
+			}
+			estimate.limbs.resize(n + 2);
+			return estimate.limbs;
+		}
+
+		void divRemBarrett(limb_type* quotient, limb_type* remainder, const limb_type* a, std::size_t an, const limb_type* d, std::size_t dn, const std::vector<limb_type>& mu) {
+			//Estimate the quotient as floor(floor(a / B^(dn-1)) * mu / B^(dn+1)), which undershoots the true quotient by at most 2.
+			const std::size_t topLimbs{ an - dn + 1 };
+			std::vector<limb_type> product(topLimbs + mu.size());
+			mul(product.data(), a + dn - 1, topLimbs, mu.data(), mu.size());
+			std::vector<limb_type> estimate(product.begin() + (dn + 1), product.end());
+			estimate.resize(topLimbs);
+
+			//The remainder a - estimate*d is then below 3d, and is fixed up with at most two subtractions.
+			std::vector<limb_type> working(topLimbs + dn);
+			mul(working.data(), estimate.data(), topLimbs, d, dn);
+			subUnequal(working.data(), a, an, working.data(), an);
+			working.resize(an);
+			while (compare(working.data(), an, d, dn) >= 0) {
+				subUnequal(working.data(), working.data(), an, d, dn);
+				addSingle(estimate.data(), estimate.data(), topLimbs, 1);
+			}
+			if (quotient) std::copy(estimate.begin(), estimate.end(), quotient);
+			if (remainder) std::copy(working.begin(), working.begin() + dn, remainder);
+		}
+
+
+		/*
+		* MONTGOMERY REDUCTION
+		*/
+		limb_type montgomeryInverse(limb_type m) {
+			//m is its own inverse mod 8, and each Newton step x' = x(2 - mx) doubles the number of correct bits: 3, 6, 12, 24, 48, 96.
+			limb_type inverse{ m };
+			for (int i = 0; i < 5; ++i) {
+				inverse *= 2 - m * inverse;
+			}
+			return 0 - inverse;
+		}
+
+		void montgomeryReduce(limb_type* out, limb_type* t, const limb_type* m, std::size_t n, limb_type inverse) {
+			//Each step adds the multiple of m which clears the lowest remaining limb of t, after which that limb can be dropped.
+			//The carries run on into the top half, and anything past the top of t is kept in overflow.
+			limb_type overflow{ 0 };
+			for (std::size_t i = 0; i < n; ++i) {
+				const limb_type carry{ addMulSingle(t + i, m, n, t[i] * inverse) };
+				overflow += addSingle(t + i + n, t + i + n, n - i, carry);
+			}
+			//What's left is below 2m, so at most one subtraction finishes the job.
+			if (overflow != 0 || compare(t + n, n, m, n) >= 0) subSame(out, t + n, m, n);
+			else std::copy(t + n, t + 2 * n, out);
+		}
+
+
+		/*
+		* GCD
+		*/
+		LehmerMatrix lehmerMatrix(const limb_type* u, std::size_t un, const limb_type* v, std::size_t vn) {
+			//v is read as though zero-extended to un limbs, so that its leading bits line up with u's.
+			const unsigned shift{ static_cast<unsigned>(countLeadingZeros(u[un - 1])) };
+			limb_type vTop[2]{ 0, 0 };
+			if (vn >= un) vTop[1] = v[un - 1];
+			if (un >= 2 && vn >= un - 1) vTop[0] = v[un - 2];
+
+			std::int64_t uHat{ leadingBits(u, un, shift) };
+			std::int64_t vHat{ un >= 2 ? leadingBits(vTop, 2, shift) : leadingBits(vTop + 1, 1, shift) };
+
+			//Knuth's Algorithm L (TAOCP 4.5.2). The quotients of (uHat + a) / (vHat + c) and (uHat + b) / (vHat + d) bracket the true quotient,
+			//so while they agree it is known exactly.
+			LehmerMatrix m{ 1, 0, 0, 1 };
+			while (vHat + m.c != 0 && vHat + m.d != 0) {
+				const std::int64_t q{ (uHat + m.a) / (vHat + m.c) };
+				if (q != (uHat + m.b) / (vHat + m.d)) break;
+				const std::int64_t nextC{ m.a - q * m.c };
+				const std::int64_t nextD{ m.b - q * m.d };
+				const std::int64_t nextV{ uHat - q * vHat };
+				m = LehmerMatrix{ m.c, m.d, nextC, nextD };
+				uHat = vHat;
+				vHat = nextV;
+			}
+			return m;
+		}
+
+		void lehmerUpdate(limb_type* u, limb_type* v, std::size_t n, const LehmerMatrix& m, limb_type* scratch) {
+			combine(scratch, u, v, n, m.a, m.b);
+			combine(scratch + n + 1, u, v, n, m.c, m.d);
+			std::copy(scratch, scratch + n, u);
+			std::copy(scratch + n + 1, scratch + 2 * n + 1, v);
+		}
+
+		std::size_t gcd(limb_type* out, const limb_type* a, std::size_t an, const limb_type* b, std::size_t bn) {
+			//Both values are copied into buffers large enough for either, so that u and v can trade places by pointer.
+			const std::size_t size{ std::max(an, bn) };
+			std::vector<limb_type> working(4 * size + 2, 0);
+			limb_type* u{ working.data() };
+			limb_type* v{ u + size };
+			limb_type* scratch{ v + size };
+			std::copy(a, a + an, u);
+			std::copy(b, b + bn, v);
+			std::size_t un{ an };
+			std::size_t vn{ bn };
+			if (compare(u, un, v, vn) < 0) {
+				std::swap(u, v);
+				std::swap(un, vn);
+			}
+
+			std::vector<limb_type> quotient;
+			while (vn > 2) {
+				const LehmerMatrix m{ lehmerMatrix(u, un, v, vn) };
+				if (m.b == 0) {
+					//The quotient is too large for the leading bits to find, which happens when the values differ greatly in length, so take a full division.
+					quotient.resize(un - vn + 1);
+					divRem(quotient.data(), scratch, u, un, v, vn);
+					std::copy(scratch, scratch + vn, u);
+					un = trimmedSize(u, vn);
+					std::swap(u, v);
+					std::swap(un, vn);
+				}
+				else {
+					std::fill(v + vn, v + un, 0);
+					lehmerUpdate(u, v, un, m, scratch);
+					vn = trimmedSize(v, un);
+					un = trimmedSize(u, un);
+				}
+			}
+
+			//v now fits in two limbs, so one division brings u down to size and the binary GCD does the rest.
+			if (vn != 0 && un > 2) {
+				quotient.resize(un - vn + 1);
+				divRem(quotient.data(), scratch, u, un, v, vn);
+				std::copy(scratch, scratch + vn, u);
+				un = trimmedSize(u, vn);
+				std::swap(u, v);
+				std::swap(un, vn);
+			}
+			if (vn == 0) {
+				std::copy(u, u + un, out);
+				return un;
+			}
+			limb_type high{ un == 2 ? u[1] : 0 };
+			limb_type low{ u[0] };
+			gcdTwoLimbs(high, low, vn == 2 ? v[1] : 0, v[0]);
+			out[0] = low;
+			if (high == 0) return 1;
+			out[1] = high;
+			return 2;
+		}
+
+	}
+}
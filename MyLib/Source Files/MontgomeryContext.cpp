@@ -0,0 +1,113 @@
+#include "MontgomeryContext.h"
+#include "BigIntKernels.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace dp {
+
+	MontgomeryContext::MontgomeryContext(const BigInt& modulus) : m_modulus{ modulus } {
+		if (!modulus.m_sign || modulus == 0 || (modulus.m_bits[0] & 1) == 0) {
+			throw std::invalid_argument{ "MontgomeryContext: the modulus must be odd and positive" };
+		}
+		m_size = modulus.m_bits.size();
+		m_inverse = detail::montgomeryInverse(modulus.m_bits[0]);
+
+		//R^2 mod n is the one place we need a general division, and it only happens here.
+		const BigInt rSquared{ BigInt{ 1 }.xLS(2 * BigInt::unitSize * m_size) % modulus };
+		m_rSquared.assign(m_size, 0);
+		std::copy(rSquared.m_bits.begin(), rSquared.m_bits.end(), m_rSquared.begin());
+
+		m_product.resize(2 * m_size);
+		m_left.resize(m_size);
+		m_right.resize(m_size);
+
+		//R mod n is R^2 taken out of Montgomery form once.
+		std::vector<limb_type> unit(m_size, 0);
+		unit[0] = 1;
+		m_one.resize(m_size);
+		multiply(m_one.data(), m_rSquared.data(), unit.data());
+	}
+
+	const BigInt& MontgomeryContext::modulus() const {
+		return m_modulus;
+	}
+
+	void MontgomeryContext::multiply(limb_type* out, const limb_type* a, const limb_type* b) {
+		detail::mul(m_product.data(), a, m_size, b, m_size);
+		detail::montgomeryReduce(out, m_product.data(), m_modulus.m_bits.data(), m_size, m_inverse);
+	}
+
+	void MontgomeryContext::square(limb_type* out, const limb_type* a) {
+		detail::sqr(m_product.data(), a, m_size);
+		detail::montgomeryReduce(out, m_product.data(), m_modulus.m_bits.data(), m_size, m_inverse);
+	}
+
+	void MontgomeryContext::load(const BigInt& value, std::vector<limb_type>& out) const {
+		const BigInt* reduced{ &value };
+		BigInt remainder;
+		if (!value.m_sign || value >= m_modulus) {
+			remainder = value % m_modulus;
+			if (!remainder.m_sign) remainder += m_modulus;
+			reduced = &remainder;
+		}
+		std::fill(out.begin(), out.end(), 0);
+		std::copy(reduced->m_bits.begin(), reduced->m_bits.end(), out.begin());
+	}
+
+	BigInt MontgomeryContext::toBigInt(const std::vector<limb_type>& limbs) const {
+		BigInt solution;
+		solution.m_bits.assign(limbs.data(), limbs.data() + limbs.size());
+		solution.trimLeadingZeroes();
+		return solution;
+	}
+
+	//With a and b in ordinary form, one reduction of their product gives abR^-1, and multiplying that by R^2 brings it back to ab.
+	BigInt MontgomeryContext::mulmod(const BigInt& a, const BigInt& b) {
+		load(a, m_left);
+		load(b, m_right);
+		multiply(m_left.data(), m_left.data(), m_right.data());
+		multiply(m_left.data(), m_left.data(), m_rSquared.data());
+		return toBigInt(m_left);
+	}
+
+	BigInt MontgomeryContext::sqrmod(const BigInt& a) {
+		load(a, m_left);
+		square(m_left.data(), m_left.data());
+		multiply(m_left.data(), m_left.data(), m_rSquared.data());
+		return toBigInt(m_left);
+	}
+
+	BigInt MontgomeryContext::powmod(const BigInt& base, const BigInt& exponent) {
+		if (!exponent.m_sign) throw std::invalid_argument{ "MontgomeryContext: powmod requires a non-negative exponent" };
+
+		//The base goes into Montgomery form once, the exponentiation runs entirely within it, and a final reduction by 1 brings the result back out.
+		load(base, m_right);
+		multiply(m_right.data(), m_right.data(), m_rSquared.data());
+		m_left = m_one;
+
+		//Build the table of odd powers base, base^3, base^5, ... for the sliding window, stepping between them by base^2.
+		const std::size_t exponentBits{ BigInt::unitSize * exponent.m_bits.size() - static_cast<std::size_t>(detail::countLeadingZeros(exponent.m_bits.back() | 1)) };
+		const unsigned window{ detail::exponentWindow(exponentBits) };
+		const std::size_t tableSize{ static_cast<std::size_t>(1) << (window - 1) };
+		m_powers.resize(tableSize * m_size);
+		std::copy(m_right.begin(), m_right.end(), m_powers.begin());
+		if (tableSize > 1) {
+			square(m_right.data(), m_right.data());
+			for (std::size_t i = 1; i < tableSize; ++i) {
+				multiply(m_powers.data() + i * m_size, m_powers.data() + (i - 1) * m_size, m_right.data());
+			}
+		}
+
+		detail::slidingWindowExponent(exponent.m_bits.data(), exponent.m_bits.size(), window,
+			[this](std::size_t index) { std::copy(m_powers.begin() + index * m_size, m_powers.begin() + (index + 1) * m_size, m_left.begin()); },
+			[this]() { square(m_left.data(), m_left.data()); },
+			[this](std::size_t index) { multiply(m_left.data(), m_left.data(), m_powers.data() + index * m_size); });
+
+		std::fill(m_right.begin(), m_right.end(), 0);
+		m_right[0] = 1;
+		multiply(m_left.data(), m_left.data(), m_right.data());
+		return toBigInt(m_left);
+	}
+
+}
@@ -0,0 +1,362 @@
+#include "Primality.h"
+#include "MontgomeryContext.h"
+#include "BigIntKernels.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+//Helpers for the primality tests which are not needed outside of this file.
+namespace {
+
+	using dp::BigInt;
+	using limb_type = BigInt::arrayType;
+
+	/*
+	* THE SMALL PRIMES
+	*/
+	constexpr std::size_t smallPrimeBound{ 1024 };
+
+	//A sieve of Eratosthenes over [0, smallPrimeBound), run at compile time.
+	constexpr std::array<bool, smallPrimeBound> sieve() {
+		std::array<bool, smallPrimeBound> composite{};
+		composite[0] = composite[1] = true;
+		for (std::size_t i = 2; i * i < smallPrimeBound; ++i) {
+			if (composite[i]) continue;
+			for (std::size_t j = i * i; j < smallPrimeBound; j += i) composite[j] = true;
+		}
+		return composite;
+	}
+
+	constexpr std::size_t countOddPrimes() {
+		const auto composite{ sieve() };
+		std::size_t count{ 0 };
+		for (std::size_t i = 3; i < smallPrimeBound; i += 2) {
+			if (!composite[i]) ++count;
+		}
+		return count;
+	}
+
+	constexpr std::array<limb_type, countOddPrimes()> oddPrimes() {
+		const auto composite{ sieve() };
+		std::array<limb_type, countOddPrimes()> primes{};
+		std::size_t count{ 0 };
+		for (std::size_t i = 3; i < smallPrimeBound; i += 2) {
+			if (!composite[i]) primes[count++] = i;
+		}
+		return primes;
+	}
+
+	constexpr auto smallPrimes{ oddPrimes() };
+
+	//A run of consecutive small primes whose product fits in a limb. One single-limb remainder by the product gives n's residue to the whole run,
+	//and the residues to the primes themselves then come from that with ordinary 64-bit arithmetic.
+	struct PrimeGroup {
+		limb_type product;
+		std::size_t first;
+		std::size_t last;
+	};
+
+	const std::vector<PrimeGroup>& primeGroups() {
+		static const std::vector<PrimeGroup> groups{ [] {
+			std::vector<PrimeGroup> built;
+			std::size_t first{ 0 };
+			while (first < smallPrimes.size()) {
+				PrimeGroup group{ smallPrimes[first], first, first + 1 };
+				while (group.last < smallPrimes.size() && group.product <= std::numeric_limits<limb_type>::max() / smallPrimes[group.last]) {
+					group.product *= smallPrimes[group.last++];
+				}
+				built.push_back(group);
+				first = group.last;
+			}
+			return built;
+		}() };
+		return groups;
+	}
+
+	//The residues of n to each of the small primes, in the same order as smallPrimes. n must be positive.
+	std::array<limb_type, smallPrimes.size()> smallResidues(const BigInt& n) {
+		std::array<limb_type, smallPrimes.size()> residues{};
+		for (const auto& group : primeGroups()) {
+			const limb_type groupResidue{ static_cast<limb_type>(n % group.product) };
+			for (std::size_t i = group.first; i < group.last; ++i) residues[i] = groupResidue % smallPrimes[i];
+		}
+		return residues;
+	}
+
+	enum class TrialDivision { prime, composite, unknown };
+
+	//Settles n if it has a small factor, or is small enough that having none proves it prime. n must be at least 2.
+	TrialDivision trialDivide(const BigInt& n) {
+		if ((static_cast<limb_type>(n) & 1) == 0) return n == 2 ? TrialDivision::prime : TrialDivision::composite;
+		const auto residues{ smallResidues(n) };
+		for (std::size_t i = 0; i < smallPrimes.size(); ++i) {
+			if (residues[i] == 0) return n == smallPrimes[i] ? TrialDivision::prime : TrialDivision::composite;
+		}
+		if (n < smallPrimeBound * smallPrimeBound) return TrialDivision::prime;
+		return TrialDivision::unknown;
+	}
+
+	/*
+	* MODULAR ARITHMETIC
+	*/
+	//The limbs of a non-negative x, zero-extended to at least size limbs.
+	std::vector<limb_type> limbsOf(const BigInt& x, std::size_t size = 0) {
+		std::vector<limb_type> limbs(x.limbs().begin(), x.limbs().end());
+		if (limbs.size() < size) limbs.resize(size, 0);
+		return limbs;
+	}
+
+	//Arithmetic modulo an odd n on values held in Montgomery form as plain limb arrays. The Lucas test is a long chain of multiplications,
+	//additions and halvings, and MontgomeryContext's interface takes every value in and out of Montgomery form, which would double its cost.
+	//Every value is kept as exactly size() limbs, in [0, n).
+	class MontgomeryResidues
+	{
+		std::vector<limb_type>	m_modulus;
+		limb_type				m_inverse;
+		std::vector<limb_type>	m_rSquared;
+		std::vector<limb_type>	m_product;
+
+	public:
+		using Value = std::vector<limb_type>;
+
+		explicit MontgomeryResidues(const BigInt& n) : m_modulus{ limbsOf(n) } {
+			m_inverse = dp::detail::montgomeryInverse(m_modulus[0]);
+			m_rSquared = limbsOf(BigInt{ 1 }.xLS(128 * size()) % n, size());
+			m_product.resize(2 * size());
+		}
+
+		std::size_t size() const {
+			return m_modulus.size();
+		}
+
+		//x in [0, n) taken into Montgomery form.
+		Value fromBigInt(const BigInt& x) {
+			Value value{ limbsOf(x, size()) };
+			multiply(value, value, m_rSquared);
+			return value;
+		}
+
+		void multiply(Value& out, const Value& a, const Value& b) {
+			dp::detail::mul(m_product.data(), a.data(), size(), b.data(), size());
+			dp::detail::montgomeryReduce(out.data(), m_product.data(), m_modulus.data(), size(), m_inverse);
+		}
+
+		void square(Value& out, const Value& a) {
+			dp::detail::sqr(m_product.data(), a.data(), size());
+			dp::detail::montgomeryReduce(out.data(), m_product.data(), m_modulus.data(), size(), m_inverse);
+		}
+
+		void add(Value& out, const Value& a, const Value& b) const {
+			const limb_type carry{ dp::detail::addSame(out.data(), a.data(), b.data(), size()) };
+			if (carry != 0 || dp::detail::compare(out.data(), size(), m_modulus.data(), size()) >= 0) dp::detail::subSame(out.data(), out.data(), m_modulus.data(), size());
+		}
+
+		void subtract(Value& out, const Value& a, const Value& b) const {
+			if (dp::detail::subSame(out.data(), a.data(), b.data(), size()) != 0) dp::detail::addSame(out.data(), out.data(), m_modulus.data(), size());
+		}
+
+		//x / 2, by adding n first if x is odd. Halving commutes with Montgomery form, so this needs no correction.
+		void halve(Value& x) const {
+			limb_type carry{ 0 };
+			if ((x[0] & 1) != 0) carry = dp::detail::addSame(x.data(), x.data(), m_modulus.data(), size());
+			dp::detail::shiftRightBits(x.data(), x.data(), size(), 1);
+			x.back() |= carry << 63;
+		}
+
+		static bool isZero(const Value& x) {
+			return std::all_of(x.begin(), x.end(), [](limb_type limb) { return limb == 0; });
+		}
+	};
+
+	//value mod n, in [0, n), for a small signed value.
+	BigInt residueOf(std::int64_t value, const BigInt& n) {
+		const BigInt magnitude{ BigInt{ static_cast<limb_type>(value < 0 ? 0 - static_cast<limb_type>(value) : static_cast<limb_type>(value)) } % n };
+		return (value < 0 && !(magnitude == 0)) ? n - magnitude : magnitude;
+	}
+
+	//The Jacobi symbol (a/m) for odd m, on single limbs.
+	int jacobi(limb_type a, limb_type m) {
+		int result{ 1 };
+		a %= m;
+		while (a != 0) {
+			while ((a & 1) == 0) {
+				a >>= 1;
+				if ((m & 7) == 3 || (m & 7) == 5) result = -result;
+			}
+			std::swap(a, m);
+			if ((a & 3) == 3 && (m & 3) == 3) result = -result;
+			a %= m;
+		}
+		return m == 1 ? result : 0;
+	}
+
+	//The Jacobi symbol (a/n) for a small signed a and odd n > |a|. By reciprocity this is (n mod |a| / |a|) up to sign, so the only multi-limb step
+	//is a single-limb remainder.
+	int jacobi(std::int64_t a, const BigInt& n) {
+		const limb_type nLow{ static_cast<limb_type>(n) };
+		int result{ 1 };
+		limb_type magnitude{ static_cast<limb_type>(a) };
+		if (a < 0) {
+			magnitude = 0 - magnitude;
+			if ((nLow & 3) == 3) result = -result;
+		}
+		while ((magnitude & 1) == 0) {
+			magnitude >>= 1;
+			if ((nLow & 7) == 3 || (nLow & 7) == 5) result = -result;
+		}
+		if ((magnitude & 3) == 3 && (nLow & 3) == 3) result = -result;
+		return result * jacobi(static_cast<limb_type>(n % magnitude), magnitude);
+	}
+
+	/*
+	* THE TESTS
+	*/
+	//Whether n is a strong probable prime to the given base, where n - 1 = d * 2^s with d odd.
+	bool strongProbablePrime(dp::MontgomeryContext& context, const BigInt& base, const BigInt& d, std::size_t s, const BigInt& nMinusOne) {
+		BigInt x{ context.powmod(base, d) };
+		if (x == 1 || x == nMinusOne) return true;
+		for (std::size_t r = 1; r < s; ++r) {
+			x = context.sqrmod(x);
+			if (x == nMinusOne) return true;
+			if (x == 1) return false;
+		}
+		return false;
+	}
+
+	//Splits n - 1 (or n + 1) into d * 2^s with d odd, returning s.
+	std::size_t removeTwos(BigInt& d) {
+		std::size_t s{ 0 };
+		while ((static_cast<limb_type>(d) & 1) == 0) {
+			d >>= 1;
+			++s;
+		}
+		return s;
+	}
+
+	//A uniformly random value in [2, n - 2], for n > 4.
+	BigInt randomBase(const BigInt& n) {
+		thread_local std::mt19937_64 engine{ std::random_device{}() };
+		//Drawing 64 bits more than n has makes the bias from the final reduction negligible.
+		BigInt::LimbBuffer limbs;
+		for (std::size_t i = 0; i <= n.limbs().size(); ++i) limbs.push_back(engine());
+		return BigInt{ std::move(limbs) } % (n - 3) + 2;
+	}
+
+	//The strong Lucas probable-prime test with Selfridge's parameters: D is the first of 5, -7, 9, -11, ... with (D/n) = -1, P = 1 and
+	//Q = (1 - D) / 4. With n + 1 = d * 2^s, n passes if U_d = 0 or V_(d*2^r) = 0 for some r < s (mod n).
+	bool strongLucasProbablePrime(const BigInt& n) {
+		//No suitable D exists for a square, so the search below would never end.
+		if (isPerfectSquare(n)) return false;
+		std::int64_t discriminant{ 5 };
+		while (true) {
+			const int symbol{ jacobi(discriminant, n) };
+			if (symbol == -1) break;
+			if (symbol == 0) return false;
+			discriminant = discriminant > 0 ? -(discriminant + 2) : -(discriminant - 2);
+		}
+		MontgomeryResidues ring{ n };
+		const auto d{ ring.fromBigInt(residueOf(discriminant, n)) };
+		const auto q{ ring.fromBigInt(residueOf((1 - discriminant) / 4, n)) };
+
+		BigInt exponent{ n + 1 };
+		const std::size_t s{ removeTwos(exponent) };
+		const std::vector<limb_type> exponentLimbs{ limbsOf(exponent) };
+		std::size_t bit{ 64 * exponentLimbs.size() - 1 - static_cast<std::size_t>(dp::detail::countLeadingZeros(exponentLimbs.back())) };
+
+		//Walk the bits of the exponent from the top, doubling the index at each one with U_2k = U_k V_k and V_2k = V_k^2 - 2Q^k, and stepping
+		//it on by one with U_k+1 = (U_k + V_k) / 2 and V_k+1 = (D U_k + V_k) / 2 wherever the bit is set.
+		auto u{ ring.fromBigInt(BigInt{ 1 }) };
+		auto v{ u };
+		auto qPower{ q };
+		auto temporary{ u };
+		auto doubleV = [&]() {
+			ring.square(v, v);
+			ring.add(temporary, qPower, qPower);
+			ring.subtract(v, v, temporary);
+			ring.square(qPower, qPower);
+		};
+		while (bit-- > 0) {
+			ring.multiply(u, u, v);
+			doubleV();
+			if (((exponentLimbs[bit / 64] >> (bit % 64)) & 1) != 0) {
+				ring.multiply(temporary, d, u);
+				ring.add(u, u, v);
+				ring.halve(u);
+				ring.add(v, temporary, v);
+				ring.halve(v);
+				ring.multiply(qPower, qPower, q);
+			}
+		}
+		if (MontgomeryResidues::isZero(u) || MontgomeryResidues::isZero(v)) return true;
+		for (std::size_t r = 1; r < s; ++r) {
+			doubleV();
+			if (MontgomeryResidues::isZero(v)) return true;
+		}
+		return false;
+	}
+
+	//Baillie-PSW for an odd n with no small factors.
+	bool passesBailliePSW(const BigInt& n) {
+		dp::MontgomeryContext context{ n };
+		const BigInt nMinusOne{ n - 1 };
+		BigInt d{ nMinusOne };
+		const std::size_t s{ removeTwos(d) };
+		return strongProbablePrime(context, BigInt{ 2 }, d, s, nMinusOne) && strongLucasProbablePrime(n);
+	}
+}
+
+namespace dp {
+
+	bool millerRabin(const BigInt& n, unsigned rounds) {
+		if (!n.sign() || n < 2) return false;
+		const TrialDivision trial{ trialDivide(n) };
+		if (trial != TrialDivision::unknown) return trial == TrialDivision::prime;
+
+		MontgomeryContext context{ n };
+		const BigInt nMinusOne{ n - 1 };
+		BigInt d{ nMinusOne };
+		const std::size_t s{ removeTwos(d) };
+		for (unsigned round = 0; round < rounds; ++round) {
+			if (!strongProbablePrime(context, round == 0 ? BigInt{ 2 } : randomBase(n), d, s, nMinusOne)) return false;
+		}
+		return true;
+	}
+
+	bool bailliePSW(const BigInt& n) {
+		if (!n.sign() || n < 2) return false;
+		const TrialDivision trial{ trialDivide(n) };
+		if (trial != TrialDivision::unknown) return trial == TrialDivision::prime;
+		return passesBailliePSW(n);
+	}
+
+	BigInt nextPrime(const BigInt& n) {
+		if (!n.sign() || n < 2) return BigInt{ 2 };
+		BigInt candidate{ n + 1 };
+		if ((static_cast<limb_type>(candidate) & 1) == 0) ++candidate;
+
+		//Below the square of the sieving bound the small primes themselves are candidates, so the sieve below would skip them.
+		while (candidate < smallPrimeBound * smallPrimeBound) {
+			if (trialDivide(candidate) == TrialDivision::prime) return candidate;
+			candidate += 2;
+		}
+
+		//Each step of 2 moves every residue on by 2, so the small factors of each candidate are known without dividing it again.
+		auto residues{ smallResidues(candidate) };
+		while (true) {
+			bool sieved{ false };
+			for (std::size_t i = 0; i < smallPrimes.size() && !sieved; ++i) sieved = residues[i] == 0;
+			if (!sieved && passesBailliePSW(candidate)) return candidate;
+			candidate += 2;
+			for (std::size_t i = 0; i < smallPrimes.size(); ++i) {
+				residues[i] += 2;
+				if (residues[i] >= smallPrimes[i]) residues[i] -= smallPrimes[i];
+			}
+		}
+	}
+
+}
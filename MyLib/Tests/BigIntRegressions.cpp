@@ -0,0 +1,72 @@
+/*
+* Regression cases for BigInt bugs which have been fixed, each kept so that it stays fixed. Every case prints a line if it fails, and the program
+* returns the number of failures.
+* This is a standalone program rather than part of the library. With GCC or Clang, from the MyLib directory:
+*
+*     g++ -std=c++17 -O1 -fsanitize=address,undefined -IHeaders Tests/BigIntRegressions.cpp "Source Files"/BigInt*.cpp "Source Files"/MontgomeryContext.cpp -pthread
+*/
+
+#include "BigInt.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+
+namespace {
+
+	int failures{ 0 };
+
+	void check(bool passed, const char* description) {
+		if (passed) return;
+		std::printf("FAILED: %s\n", description);
+		++failures;
+	}
+
+	//Whether calling f throws an Exception.
+	template<typename Exception, typename Function>
+	bool throws(Function f) {
+		try {
+			f();
+		}
+		catch (const Exception&) {
+			return true;
+		}
+		return false;
+	}
+
+	/*
+	* POW
+	*/
+	//pow and the other number-theoretic functions are hidden friends of BigInt, so are found by argument-dependent lookup rather than as dp::pow.
+	void powOfOne() {
+		//These used to size their buffers for exponent bits up front, and fail with std::bad_alloc.
+		check(pow(dp::BigInt{ 1 }, std::uint64_t{ 1 } << 62) == 1, "pow(1, 2^62) is 1");
+		check(pow(dp::BigInt{ -1 }, 1000000000000) == 1, "pow(-1, 10^12) is 1");
+		check(pow(dp::BigInt{ -1 }, 1000000000001) == -1, "pow(-1, 10^12 + 1) is -1");
+	}
+
+	void powTooLarge() {
+		//The size of the result used to wrap around to 2 limbs, which were then overrun.
+		check(throws<std::length_error>([] { pow(dp::BigInt{ 3 }, std::uint64_t{ 1 } << 63); }), "pow(3, 2^63) throws std::length_error");
+		check(throws<std::length_error>([] { pow(dp::BigInt{ 1 }.xLS(200), std::uint64_t{ 1 } << 58); }), "pow(2^200, 2^58) throws std::length_error");
+	}
+
+	/*
+	* MODULAR ARITHMETIC
+	*/
+	void zeroModulus() {
+		//A zero modulus used to give 0 quietly, unlike every other argument error in the number-theoretic functions.
+		check(throws<std::invalid_argument>([] { powmod(dp::BigInt{ 3 }, dp::BigInt{ 5 }, dp::BigInt{ 0 }); }), "powmod with a zero modulus throws std::invalid_argument");
+		check(throws<std::invalid_argument>([] { modInverse(dp::BigInt{ 3 }, dp::BigInt{ 0 }); }), "modInverse with a zero modulus throws std::invalid_argument");
+	}
+
+}
+
+int main() {
+	powOfOne();
+	powTooLarge();
+	zeroModulus();
+
+	if (failures == 0) std::printf("All regression cases passed.\n");
+	return failures;
+}